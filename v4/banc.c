@@ -0,0 +1,1774 @@
+/**
+ * @file banc.c
+ * @brief Banc d'essai du jeu Snake (version 4) : parties sans terminal, sans attente ni affichage.
+ *
+ * Les parties sont jouées par un agent (glouton, aléatoire, suite de touches, ou pilote
+ * qui suit le plus court chemin vers la pomme, pilote.h, cherché à chaque déplacement ou
+ * gardé d'un déplacement à l'autre) à la vitesse de la machine. Le programme affiche le
+ * débit en déplacements et en parties par seconde, puis le temps passé dans chaque phase
+ * d'un déplacement.
+ *
+ * Avec -l, les parties sont jouées par lots avancés ensemble (lot.h) ; --verifier
+ * compare déplacement par déplacement un lot avec les mêmes parties jouées une à une.
+ * Avec -j, les parties sont réparties entre plusieurs fils d'exécution (ouvriers.h) et
+ * la distribution des scores est affichée.
+ *
+ * --cliches mesure le coût d'un cliché (recherche.h), pris puis restauré (dans le même
+ * état, puis en tournant sur des clichés pris à différents moments de la partie), puis une
+ * exploration de tous les coups sur quelques déplacements, sans table de transposition ;
+ * --table la refait avec. La table ne gagne que si le serpent est court devant la
+ * profondeur (--serpent 10) : plus long, deux chemins ne mènent presque jamais au même état.
+ * --plateau mesure un parcours complet du plateau et un remplissage depuis la tête.
+ * --pilote mesure le coût d'une décision du pilote (pilote.h) sur une même partie, avec un
+ * parcours jusqu'à la pomme à chaque déplacement ou avec le chemin gardé et réparé (la
+ * tête en est écartée régulièrement), et vérifie chaque chemin gardé contre le plus court.
+ * --largeur, --hauteur et --serpent changent les dimensions du plateau et la taille
+ * maximum du serpent de toutes les parties (le serpent grandit alors jusqu'à cette taille).
+ * Avec --preparer, les parties jouées une à une font tirer le pavage de chaque passage de
+ * niveau d'avance par un autre fil (preparation.h) : l'empreinte ne change pas, seule
+ * la phase "niveau" raccourcit. Le fil n'a que le temps où la partie l'attend, après
+ * chaque passage de niveau, comme entre deux déplacements du jeu : ce temps compte dans
+ * le débit mais pas dans les phases. La ligne "niveau prêt" ne compte que les passages
+ * dont le pavage était prêt.
+ * --recueil ouvre un recueil de niveaux (niveaux.h), mesure son ouverture et le
+ * chargement de chacun de ses niveaux, puis toutes les parties jouent le niveau
+ * --niveau (0 par défaut), aux dimensions du recueil.
+ *
+ * Utilisation : ./banc [-n parties] [-g graine] [-m déplacements max]
+ *               [-a glouton|aleatoire|touches|pilote|incremental] [-t touches] [-l taille du lot] [-j fils]
+ *               [--verifier] [--paves] [--cliches] [--table] [--plateau] [--pilote]
+ *               [--largeur N] [--hauteur N] [--serpent N] [--preparer]
+ *               [--recueil fichier] [--niveau N]
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+#include "libsnake.h"
+#include "lot.h"
+#include "ouvriers.h"
+#include "recherche.h"
+#include "preparation.h"
+#include "niveaux.h"
+#include "pilote.h"
+
+/** @brief Nombre de parties jouées par défaut */
+#define NB_PARTIES 1000
+/** @brief Nombre maximum de déplacements par partie par défaut */
+#define DEPLACEMENTS_MAX 100000
+/** @brief Nombre de déplacements mesurés pour chaque nombre de pavés dans bancPaves */
+#define DEPLACEMENTS_PAVES 1000000
+/** @brief Nombre de clichés pris et restaurés dans bancCliches */
+#define MESURES_CLICHES 1000000
+/** @brief Capacité de la réserve de bancCliches */
+#define RESERVE_CLICHES 64
+/** @brief Déplacements joués avant et après le cliché dans bancCliches */
+#define DEPLACEMENTS_CLICHES 500
+/** @brief Déplacements joués entre deux clichés de la réserve restaurée par bancCliches */
+#define ECART_CLICHES 8
+/** @brief Pas entre deux clichés restaurés à la suite, premier avec RESERVE_CLICHES */
+#define SAUT_CLICHES 29
+/** @brief Nombre de parcours complets du plateau mesurés dans bancPlateau */
+#define MESURES_PARCOURS 100000
+/** @brief Nombre de remplissages mesurés dans bancPlateau */
+#define MESURES_REMPLISSAGE 20000
+/** @brief Déplacements entre deux écarts forcés de la tête hors du chemin gardé dans bancPilote */
+#define ECART_PILOTE 25
+/** @brief Profondeur de l'exploration de bancCliches */
+#define PROFONDEUR_RECHERCHE 14
+/** @brief La table de transposition de bancCliches a 2^BITS_TABLE entrées */
+#define BITS_TABLE 20
+
+/** @typedef agent
+ * @brief Choisit la touche du prochain déplacement.
+ *
+ * @param jeu Partie en cours.
+ * @param tour Numéro du déplacement dans la partie.
+ * @param hasard État du générateur de l'agent, propre à la partie.
+ * @param lePilote Pilote neuf au début de la partie et propre à elle, pour les agents
+ *                 qui en ont un (agentAvecPilote) ; NULL sinon, ou si la mémoire manque.
+ * @return Touche jouée.
+ */
+typedef char (*agent)(const partie *jeu, long tour, unsigned int *hasard, pilote *lePilote);
+
+/** @typedef resultats
+ * @brief Totaux d'une série de parties.
+ */
+typedef struct
+{
+    long long deplacements;
+    long pommes;
+    long niveaux;
+    long morts;
+    uint64_t empreinte; // somme des empreintes des parties, indépendante de l'ordre
+    double secondes;
+} resultats;
+
+/** @typedef serieParallele
+ * @brief Réglages et résultats partagés par les fils de jouerEnParallele.
+ */
+typedef struct
+{
+    agent joueur;
+    uint64_t graine;
+    long deplacementsMax;
+    partie *parties;    // une partie par fil
+    resultats *totaux;  // un total par fil
+    int *scores;        // score de chaque partie
+} serieParallele;
+
+const char *toucheScript = "d"; // touches jouées en boucle par l'agent "touches"
+parametres reglages;            // réglages de toutes les parties, dimensions comprises
+bool preparer = false;          // pavages tirés d'avance par un autre fil dans jouerSerie
+bool transposition = false;     // exploration de bancCliches refaite avec table de transposition
+recueil niveaux;                // recueil de --recueil, projeté jusqu'à la fin du programme
+
+/**
+ * @brief Joue une partie jusqu'à sa fin ou jusqu'à deplacementsMax déplacements.
+ *
+ * @param jeu Partie à utiliser.
+ * @param joueur Agent qui choisit les touches.
+ * @param graine Graine de la partie.
+ * @param deplacementsMax Nombre maximum de déplacements.
+ * @param config Réglages de la partie.
+ * @param total Totaux auxquels la partie est ajoutée.
+ */
+void jouerPartie(partie *jeu, agent joueur, uint64_t graine, long deplacementsMax,
+                 const parametres *config, resultats *total);
+
+/**
+ * @brief Joue une série de parties et cumule leurs totaux.
+ *
+ * La partie i utilise la graine graine + i : deux séries de mêmes réglages jouent
+ * exactement les mêmes parties.
+ *
+ * @param joueur Agent qui choisit les touches.
+ * @param nbParties Nombre de parties à jouer.
+ * @param graine Graine de la première partie.
+ * @param deplacementsMax Nombre maximum de déplacements par partie.
+ * @param chrono Temps par phase à cumuler, NULL pour ne pas mesurer.
+ * @param total Totaux de la série.
+ * @return false si la mémoire manque pour la partie ou si le fil de préparation n'a pas pu être créé.
+ */
+bool jouerSerie(agent joueur, int nbParties, uint64_t graine, long deplacementsMax,
+                chronometrage *chrono, resultats *total);
+
+/**
+ * @brief Joue une série de parties par lots avancés ensemble et cumule leurs totaux.
+ *
+ * @param joueur Agent qui choisit les touches.
+ * @param nbParties Nombre de parties à jouer.
+ * @param tailleLot Nombre de parties par lot.
+ * @param graine Graine de la première partie.
+ * @param deplacementsMax Nombre maximum de déplacements par partie.
+ * @param total Totaux de la série.
+ * @return false si la mémoire manque pour le lot.
+ */
+bool jouerLots(agent joueur, int nbParties, int tailleLot, uint64_t graine, long deplacementsMax,
+               resultats *total);
+
+/**
+ * @brief Joue une série de parties réparties entre plusieurs fils d'exécution.
+ *
+ * @param joueur Agent qui choisit les touches.
+ * @param nbParties Nombre de parties à jouer.
+ * @param nbFils Nombre de fils.
+ * @param graine Graine de la première partie.
+ * @param deplacementsMax Nombre maximum de déplacements par partie.
+ * @param total Totaux de la série.
+ * @param scores Score de chaque partie.
+ * @param bilans Nombre de parties et de vols de chaque fil.
+ * @return false si la mémoire manque ou si les fils n'ont pas pu être créés.
+ */
+bool jouerEnParallele(agent joueur, int nbParties, int nbFils, uint64_t graine, long deplacementsMax,
+                      resultats *total, int scores[], bilanFil bilans[]);
+
+/**
+ * @brief Tâche d'un fil : joue la partie numéro indice.
+ *
+ * @param indice Numéro de la partie.
+ * @param fil Numéro du fil.
+ * @param donnees Série en cours (serieParallele).
+ */
+void jouerTache(int indice, int fil, void *donnees);
+
+/**
+ * @brief Affiche la distribution des scores : quantiles et histogramme.
+ *
+ * @param scores Score de chaque partie (trié par la procédure).
+ * @param nbParties Nombre de parties.
+ */
+void afficherScores(int scores[], int nbParties);
+
+/**
+ * @brief Compare deux entiers pour qsort.
+ */
+int comparerEntiers(const void *a, const void *b);
+
+/**
+ * @brief Vérifie qu'un lot donne exactement les mêmes parties que avancer, partie par partie.
+ *
+ * Chaque partie a son propre générateur : l'ordre dans lequel les parties sont
+ * jouées ne change pas leurs tirages. La clé de Zobrist tenue à jour par chaque
+ * déplacement est aussi comparée à la clé recalculée entièrement.
+ *
+ * @param joueur Agent qui choisit les touches.
+ * @param nbParties Nombre de parties du lot.
+ * @param graine Graine de la première partie.
+ * @param deplacementsMax Nombre maximum de déplacements par partie.
+ * @return true si toutes les parties sont identiques à chaque déplacement.
+ */
+bool verifierLot(agent joueur, int nbParties, uint64_t graine, long deplacementsMax);
+
+/**
+ * @brief Compare l'état de deux parties.
+ *
+ * @param a Première partie.
+ * @param b Seconde partie.
+ * @return true si plateau, serpent, pomme, score, niveau et clé de Zobrist sont identiques.
+ */
+bool memesParties(const partie *a, const partie *b);
+
+/**
+ * @brief Affiche le débit d'une série de parties.
+ *
+ * @param total Totaux de la série.
+ * @param nbParties Nombre de parties jouées.
+ */
+void afficherResultats(const resultats *total, int nbParties);
+
+/**
+ * @brief Affiche le temps total et moyen de chaque phase.
+ *
+ * @param chrono Temps par phase cumulés.
+ */
+void afficherPhases(const chronometrage *chrono);
+
+/**
+ * @brief Mesure le coût d'un déplacement pour un nombre croissant de pavés, jusqu'à MAX_PAVES.
+ *
+ * @return false si la mémoire manque pour la partie.
+ */
+bool bancPaves();
+
+/**
+ * @brief Mesure le temps pour prendre et restaurer un cliché en cours de partie,
+ *        et vérifie qu'une partie restaurée rejoue les mêmes déplacements.
+ *
+ * @return false si la partie restaurée diffère ou si la réserve n'a pas pu être allouée.
+ */
+bool bancCliches();
+
+/**
+ * @brief Ouvre un recueil de niveaux, règle les parties sur l'un d'eux, et mesure
+ *        l'ouverture puis le chargement de chaque niveau dans une partie.
+ *
+ * @param chemin Chemin du recueil.
+ * @param numero Numéro du niveau joué par toutes les parties.
+ * @return false si le recueil ne peut pas être ouvert, si le niveau n'y est pas ou si la mémoire manque.
+ */
+bool ouvrirNiveaux(const char *chemin, int numero);
+
+/**
+ * @brief Joue jusqu'à DEPLACEMENTS_CLICHES déplacements de l'agent glouton depuis la graine 1,
+ *        en défaisant le déplacement qui terminerait la partie.
+ *
+ * @param jeu Partie en cours au retour, créée aux dimensions de reglages.
+ * @param hasard Générateur de l'agent.
+ * @return false si la mémoire manque pour le cliché.
+ */
+bool milieuDePartie(partie *jeu, unsigned int *hasard);
+
+/**
+ * @brief Mesure, en milieu de partie, un parcours de toutes les cases du plateau
+ *        et un remplissage des cases atteignables depuis la tête.
+ *
+ * @return false si la mémoire manque pour la partie ou le parcours.
+ */
+bool bancPlateau();
+
+/**
+ * @brief Compte les cases libres atteignables depuis la tête, téléporteurs non compris.
+ *
+ * Parcours en largeur sur les quatre voisines de chaque case : les cases de garde
+ * arrêtent le remplissage aux bordures sans test de limite.
+ *
+ * @param jeu Partie consultée.
+ * @param file File du parcours, jeu->nbCases cases.
+ * @param vue Cases déjà atteintes, jeu->nbCases cases remises à false par la fonction.
+ * @return Nombre de cases atteintes.
+ */
+int remplir(const partie *jeu, uint32_t file[], bool vue[]);
+
+/**
+ * @brief Mesure le coût d'une décision du pilote sur une même partie, de graine 1, aux
+ *        dimensions de reglages : parcours jusqu'à la pomme à chaque déplacement
+ *        (piloter) ou chemin gardé et réparé (planifier).
+ *
+ * La partie est jouée par planifier, qui note ses touches ; tous les ECART_PILOTE
+ * déplacements, une autre touche libre écarte la tête du chemin gardé, qui doit être
+ * réparé. La partie est ensuite rejouée sans pilote, puis en appelant piloter avant
+ * chaque déplacement : le temps de la partie rejouée sans pilote est retiré des deux
+ * autres. Une dernière passe, non mesurée, compare après chaque décision de planifier
+ * le chemin gardé au plus court : il doit partir de la tête, finir à la pomme et ne
+ * pas être plus court ; il n'en manque que si la pomme est hors d'atteinte.
+ *
+ * @param deplacementsMax Nombre maximum de déplacements de la partie.
+ * @return false si la mémoire manque ou si un chemin gardé est faux.
+ */
+bool bancPilote(long deplacementsMax);
+
+/**
+ * @brief Touche qui écarte la tête du chemin prévu : la première direction sans
+ *        demi-tour dont la case d'arrivée est libre, autre que prevue.
+ *
+ * @param jeu Partie en cours.
+ * @param prevue Touche du pilote.
+ * @return Touche d'écart, prevue si aucune autre direction n'est libre.
+ */
+char ecartForce(const partie *jeu, char prevue);
+
+/**
+ * @brief Longueur du plus court chemin de la tête à la pomme, téléporteurs compris,
+ *        sans demi-tour au premier pas.
+ *
+ * @param jeu Partie consultée.
+ * @param file File du parcours, jeu->nbCases cases.
+ * @param distance Pas depuis la tête, jeu->nbCases cases à -1, remises à -1 par la fonction.
+ * @return Nombre de pas, -1 si la pomme est hors d'atteinte.
+ */
+int plusCourt(const partie *jeu, uint32_t file[], int distance[]);
+
+/**
+ * @brief Explore tous les coups jusqu'à une profondeur donnée et renvoie le meilleur score atteint.
+ *
+ * Chaque coup est joué sur la partie puis défait en restaurant un cliché pris dans
+ * la réserve. Avec une table, un état déjà exploré à la même profondeur n'est pas
+ * réexploré.
+ *
+ * @param jeu Partie explorée, remise dans son état au retour.
+ * @param laReserve Réserve d'au moins profondeur clichés libres.
+ * @param table Table de transposition, NULL pour tout explorer.
+ * @param profondeur Nombre de déplacements explorés.
+ * @param noeuds Incrémenté pour chaque état visité.
+ * @return Plus grand nombre de pommes mangées sans mourir, -1 si tous les coups meurent.
+ */
+int explorer(partie *jeu, reserve *laReserve, tableTransposition *table, int profondeur, long *noeuds);
+
+/**
+ * @brief Agent qui va vers la pomme en évitant, si possible, les cases bloquées voisines.
+ */
+char agentGlouton(const partie *jeu, long tour, unsigned int *hasard, pilote *lePilote);
+
+/**
+ * @brief Agent qui joue une direction au hasard.
+ */
+char agentAleatoire(const partie *jeu, long tour, unsigned int *hasard, pilote *lePilote);
+
+/**
+ * @brief Agent qui joue en boucle les touches de toucheScript.
+ */
+char agentTouches(const partie *jeu, long tour, unsigned int *hasard, pilote *lePilote);
+
+/**
+ * @brief Agent qui suit le plus court chemin vers la pomme, cherché à chaque déplacement (pilote.h).
+ */
+char agentPilote(const partie *jeu, long tour, unsigned int *hasard, pilote *lePilote);
+
+/**
+ * @brief Agent qui suit le chemin gardé par le pilote, réparé au besoin et cherché
+ *        de nouveau à chaque pomme (pilote.h).
+ */
+char agentIncremental(const partie *jeu, long tour, unsigned int *hasard, pilote *lePilote);
+
+/**
+ * @brief Indique si un agent conduit sa partie avec un pilote.
+ */
+bool agentAvecPilote(agent joueur);
+
+/**
+ * @brief Donne un pilote neuf à chaque partie d'un lot, si l'agent en a un.
+ *
+ * Les pilotes de la série précédente du lot sont détruits d'abord : chaque partie
+ * commence sans chemin gardé.
+ *
+ * @param pilotes Un pilote par partie du lot, vides ou créés par un appel précédent.
+ * @param leLot Lot de parties, déjà initialisées.
+ * @param joueur Agent des parties.
+ * @return false si la mémoire manque.
+ */
+bool renouvelerPilotes(pilote pilotes[], const lot *leLot, agent joueur);
+
+/**
+ * @brief Indique si la case voisine de la tête dans une direction donnée est libre.
+ *
+ * @param jeu Partie en cours.
+ * @param direction Direction testée.
+ * @return true si la tête peut y aller sans collision immédiate.
+ */
+bool voisineLibre(const partie *jeu, char direction);
+
+/**
+ * @brief Tire un entier pseudo-aléatoire sans toucher au générateur du jeu.
+ *
+ * @param hasard État du générateur.
+ * @return Entier entre 0 et 32767.
+ */
+int tirage(unsigned int *hasard);
+
+/**
+ * @brief Résume le résultat d'une partie en un entier de 64 bits.
+ *
+ * La somme des empreintes de toutes les parties ne dépend ni de l'ordre des parties
+ * ni du nombre de fils : elle change dès qu'une partie se joue autrement.
+ *
+ * @param graine Graine de la partie.
+ * @param jeu Partie terminée.
+ * @param deplacements Nombre de déplacements joués.
+ * @return Empreinte de la partie.
+ */
+uint64_t empreintePartie(uint64_t graine, const partie *jeu, long deplacements);
+
+/**
+ * @brief Durée écoulée entre deux instants.
+ *
+ * @param debut Premier instant.
+ * @param fin Second instant.
+ * @return Durée en secondes.
+ */
+double secondesEntre(const struct timespec *debut, const struct timespec *fin);
+
+/*****************************************************
+ *                 PROGRAMME PRINCIPALE              *
+ *****************************************************/
+int main(int argc, char *argv[])
+{
+    int nbParties = NB_PARTIES;
+    uint64_t graine = 1;
+    long deplacementsMax = DEPLACEMENTS_MAX;
+    agent joueur = agentGlouton;
+    const char *nomAgent = "glouton";
+    int tailleLot = 0;
+    int nbFils = 0;
+    int *scores;
+    bilanFil bilans[NB_FILS_MAX];
+    bool verifier = false;
+    const char *mesure = NULL;
+    const char *cheminRecueil = NULL;
+    int numeroNiveau = 0;
+    chronometrage chrono;
+    resultats total;
+
+    parametresParDefaut(&reglages);
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+        {
+            nbParties = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-g") == 0) && (i + 1 < argc))
+        {
+            graine = strtoull(argv[++i], NULL, 10);
+        }
+        else if ((strcmp(argv[i], "-m") == 0) && (i + 1 < argc))
+        {
+            deplacementsMax = atol(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc) && (argv[i + 1][0] != '\0'))
+        {
+            toucheScript = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-a") == 0) && (i + 1 < argc))
+        {
+            nomAgent = argv[++i];
+            if (strcmp(nomAgent, "glouton") == 0)
+            {
+                joueur = agentGlouton;
+            }
+            else if (strcmp(nomAgent, "aleatoire") == 0)
+            {
+                joueur = agentAleatoire;
+            }
+            else if (strcmp(nomAgent, "touches") == 0)
+            {
+                joueur = agentTouches;
+            }
+            else if (strcmp(nomAgent, "pilote") == 0)
+            {
+                joueur = agentPilote;
+            }
+            else if (strcmp(nomAgent, "incremental") == 0)
+            {
+                joueur = agentIncremental;
+            }
+            else
+            {
+                fprintf(stderr, "agent inconnu : %s (glouton, aleatoire, touches, pilote ou incremental)\n", nomAgent);
+                return EXIT_FAILURE;
+            }
+        }
+        else if ((strcmp(argv[i], "-l") == 0) && (i + 1 < argc))
+        {
+            tailleLot = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-j") == 0) && (i + 1 < argc))
+        {
+            nbFils = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--verifier") == 0)
+        {
+            verifier = true;
+        }
+        else if ((strcmp(argv[i], "--paves") == 0) || (strcmp(argv[i], "--plateau") == 0)
+              || (strcmp(argv[i], "--cliches") == 0) || (strcmp(argv[i], "--pilote") == 0))
+        {
+            // lancée après la lecture de toutes les options, pour tenir compte des dimensions
+            mesure = argv[i];
+        }
+        else if ((strcmp(argv[i], "--largeur") == 0) && (i + 1 < argc))
+        {
+            reglages.largeur = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--hauteur") == 0) && (i + 1 < argc))
+        {
+            reglages.hauteur = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--serpent") == 0) && (i + 1 < argc))
+        {
+            reglages.tailleMax = atoi(argv[++i]);
+            reglages.tailleSerpent = reglages.tailleMax;
+        }
+        else if (strcmp(argv[i], "--preparer") == 0)
+        {
+            preparer = true;
+        }
+        else if (strcmp(argv[i], "--table") == 0)
+        {
+            transposition = true;
+        }
+        else if ((strcmp(argv[i], "--recueil") == 0) && (i + 1 < argc))
+        {
+            cheminRecueil = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--niveau") == 0) && (i + 1 < argc))
+        {
+            numeroNiveau = atoi(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr, "usage : %s [-n parties] [-g graine] [-m déplacements max] "
+                            "[-a glouton|aleatoire|touches|pilote|incremental] [-t touches] [-l taille du lot] [-j fils] [--verifier] [--paves] [--cliches] [--table] [--plateau] [--pilote] "
+                            "[--largeur N] [--hauteur N] [--serpent N] [--preparer] [--recueil fichier] [--niveau N]\n",
+                    argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // les dimensions du recueil remplacent --largeur et --hauteur
+    if ((cheminRecueil != NULL) && !ouvrirNiveaux(cheminRecueil, numeroNiveau))
+    {
+        return EXIT_FAILURE;
+    }
+    if ((reglages.largeur < LARGEUR_PLUS_PETITE) || (reglages.largeur > DIMENSION_MAX)
+     || (reglages.hauteur < HAUTEUR_PLUS_PETITE) || (reglages.hauteur > DIMENSION_MAX)
+     || (reglages.tailleMax < TAILLE_SERPENT_INITIAL))
+    {
+        fprintf(stderr, "plateau de %d x %d ou serpent de %d segments impossible "
+                        "(largeur %d à %d, hauteur %d à %d, serpent d'au moins %d segments)\n",
+                reglages.largeur, reglages.hauteur, reglages.tailleMax, LARGEUR_PLUS_PETITE, DIMENSION_MAX,
+                HAUTEUR_PLUS_PETITE, DIMENSION_MAX, TAILLE_SERPENT_INITIAL);
+        return EXIT_FAILURE;
+    }
+    if ((reglages.largeur != LARGEUR_MAX) || (reglages.hauteur != HAUTEUR_MAX))
+    {
+        printf("plateau de %d x %d, serpent de %d segments au plus\n", reglages.largeur, reglages.hauteur,
+               reglages.tailleMax);
+    }
+
+    if ((mesure != NULL) && (strcmp(mesure, "--paves") == 0))
+    {
+        return bancPaves() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if ((mesure != NULL) && (strcmp(mesure, "--plateau") == 0))
+    {
+        return bancPlateau() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if ((mesure != NULL) && (strcmp(mesure, "--pilote") == 0))
+    {
+        return bancPilote(deplacementsMax) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (mesure != NULL)
+    {
+        return bancCliches() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    printf("agent %s, %d parties, graine %" PRIu64 ", au plus %ld déplacements par partie\n",
+           nomAgent, nbParties, graine, deplacementsMax);
+
+    if (verifier)
+    {
+        return verifierLot(joueur, nbParties, graine, deplacementsMax) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (tailleLot > 0)
+    {
+        printf("lots de %d parties\n", tailleLot);
+        if (!jouerLots(joueur, nbParties, tailleLot, graine, deplacementsMax, &total))
+        {
+            fprintf(stderr, "mémoire insuffisante pour un lot de %d parties\n", tailleLot);
+            return EXIT_FAILURE;
+        }
+        afficherResultats(&total, nbParties);
+        return EXIT_SUCCESS;
+    }
+
+    if (nbFils > 0)
+    {
+        printf("%d fils d'exécution\n", nbFils);
+        scores = malloc(nbParties * sizeof(int));
+        if ((scores == NULL) || !jouerEnParallele(joueur, nbParties, nbFils, graine, deplacementsMax,
+                                                  &total, scores, bilans))
+        {
+            fprintf(stderr, "impossible de lancer %d fils\n", nbFils);
+            free(scores);
+            return EXIT_FAILURE;
+        }
+        afficherResultats(&total, nbParties);
+        printf("\n%4s %10s %6s\n", "fil", "parties", "vols");
+        for (int k = 0; k < nbFils; k++)
+        {
+            printf("%4d %10d %6d\n", k, bilans[k].taches, bilans[k].vols);
+        }
+        afficherScores(scores, nbParties);
+        free(scores);
+        return EXIT_SUCCESS;
+    }
+
+    // Débit sans mesure des phases, puis les mêmes parties avec mesure
+    if (preparer)
+    {
+        printf("pavages tirés d'avance par un autre fil\n");
+    }
+    if (!jouerSerie(joueur, nbParties, graine, deplacementsMax, NULL, &total))
+    {
+        fprintf(stderr, "mémoire insuffisante pour un plateau de %d x %d\n", reglages.largeur, reglages.hauteur);
+        return EXIT_FAILURE;
+    }
+    afficherResultats(&total, nbParties);
+
+    memset(&chrono, 0, sizeof(chrono));
+    jouerSerie(joueur, nbParties, graine, deplacementsMax, &chrono, &total);
+    afficherPhases(&chrono);
+    return EXIT_SUCCESS;
+}
+
+/*****************************************************
+ *                 PROCEDURE                         *
+ *****************************************************/
+bool jouerSerie(agent joueur, int nbParties, uint64_t graine, long deplacementsMax,
+                chronometrage *chrono, resultats *total)
+{
+    partie jeu;
+    preparation prepa;
+    parametres config = reglages;
+    struct timespec debut, fin;
+    bool possible = creerPartie(&jeu, &reglages);
+    bool prepare = possible && preparer && creerPreparation(&prepa, &jeu);
+
+    memset(total, 0, sizeof(*total));
+    config.chrono = chrono;
+    if (prepare)
+    {
+        config.commander = commanderPavage;
+        config.livrer = livrerPavage;
+        config.atelier = &prepa;
+    }
+    possible = possible && (prepare || !preparer);
+
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (int i = 0; possible && (i < nbParties); i++)
+    {
+        jouerPartie(&jeu, joueur, graine + i, deplacementsMax, &config, total);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    total->secondes = secondesEntre(&debut, &fin);
+    if (prepare)
+    {
+        detruirePreparation(&prepa);
+    }
+    detruirePartie(&jeu);
+    return possible;
+}
+
+void jouerPartie(partie *jeu, agent joueur, uint64_t graine, long deplacementsMax,
+                 const parametres *config, resultats *total)
+{
+    unsigned int hasard = (unsigned int)graine;
+    int evenements = initPartie(jeu, graine, config) ? 0 : EVENEMENT_PLEIN;
+    long tour = 0;
+    long niveaux = 0;
+    pilote lePilote;
+    // un pilote neuf par partie : rien n'est repris de la partie précédente jouée dans jeu
+    bool avecPilote = agentAvecPilote(joueur) && creerPilote(&lePilote, jeu);
+
+    // compteurs locaux : total peut être voisin en mémoire de celui d'un autre fil
+    while ((tour < deplacementsMax) && ((evenements & EVENEMENT_FIN) == 0))
+    {
+        // la partie ne s'arrête pas entre deux déplacements : le temps que le jeu laisse au fil est pris ici
+        if (((tour == 0) || (evenements & EVENEMENT_NIVEAU)) && (config->commander == commanderPavage))
+        {
+            attendrePavage(config->atelier);
+        }
+        evenements = avancer(jeu, joueur(jeu, tour, &hasard, avecPilote ? &lePilote : NULL));
+        tour++;
+        if (evenements & EVENEMENT_NIVEAU)
+        {
+            niveaux++;
+        }
+    }
+    if (avecPilote)
+    {
+        detruirePilote(&lePilote);
+    }
+    total->deplacements += tour;
+    total->niveaux += niveaux;
+    total->pommes += jeu->numeroPomme;
+    total->empreinte += empreintePartie(graine, jeu, tour);
+    if (evenements & EVENEMENT_MORT)
+    {
+        total->morts++;
+    }
+}
+
+bool jouerEnParallele(agent joueur, int nbParties, int nbFils, uint64_t graine, long deplacementsMax,
+                      resultats *total, int scores[], bilanFil bilans[])
+{
+    serieParallele serie;
+    struct timespec debut, fin;
+    bool possible;
+
+    serie.joueur = joueur;
+    serie.graine = graine;
+    serie.deplacementsMax = deplacementsMax;
+    serie.scores = scores;
+    serie.parties = calloc(nbFils, sizeof(partie));
+    serie.totaux = calloc(nbFils, sizeof(resultats));
+    possible = (nbFils >= 1) && (serie.parties != NULL) && (serie.totaux != NULL);
+    for (int k = 0; possible && (k < nbFils); k++)
+    {
+        possible = creerPartie(&serie.parties[k], &reglages);
+    }
+
+    memset(total, 0, sizeof(*total));
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    possible = possible && repartirTaches(nbParties, nbFils, jouerTache, &serie, bilans);
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    total->secondes = secondesEntre(&debut, &fin);
+
+    for (int k = 0; possible && (k < nbFils); k++)
+    {
+        total->deplacements += serie.totaux[k].deplacements;
+        total->pommes += serie.totaux[k].pommes;
+        total->niveaux += serie.totaux[k].niveaux;
+        total->morts += serie.totaux[k].morts;
+        total->empreinte += serie.totaux[k].empreinte;
+    }
+    for (int k = 0; (serie.parties != NULL) && (k < nbFils); k++)
+    {
+        detruirePartie(&serie.parties[k]);
+    }
+    free(serie.parties);
+    free(serie.totaux);
+    return possible;
+}
+
+void jouerTache(int indice, int fil, void *donnees)
+{
+    serieParallele *serie = donnees;
+
+    jouerPartie(&serie->parties[fil], serie->joueur, serie->graine + indice, serie->deplacementsMax,
+                &reglages, &serie->totaux[fil]);
+    serie->scores[indice] = serie->parties[fil].numeroPomme;
+}
+
+void afficherScores(int scores[], int nbParties)
+{
+    int histogramme[10] = {0};
+    int largeur;
+    long long somme = 0;
+
+    if (nbParties > 0)
+    {
+        qsort(scores, nbParties, sizeof(int), comparerEntiers);
+        for (int i = 0; i < nbParties; i++)
+        {
+            somme += scores[i];
+        }
+        printf("\nscores : min %d, médiane %d, 90e centile %d, 99e centile %d, max %d, moyenne %.2f\n",
+               scores[0], scores[nbParties / 2], scores[(long long)nbParties * 90 / 100],
+               scores[(long long)nbParties * 99 / 100], scores[nbParties - 1], (double)somme / nbParties);
+
+        // dix tranches de même largeur entre 0 et le meilleur score
+        largeur = scores[nbParties - 1] / 10 + 1;
+        for (int i = 0; i < nbParties; i++)
+        {
+            histogramme[scores[i] / largeur]++;
+        }
+        for (int t = 0; t < 10; t++)
+        {
+            printf("%6d - %-6d %8d\n", t * largeur, (t + 1) * largeur - 1, histogramme[t]);
+        }
+    }
+}
+
+int comparerEntiers(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+bool jouerLots(agent joueur, int nbParties, int tailleLot, uint64_t graine, long deplacementsMax,
+               resultats *total)
+{
+    lot leLot;
+    char *touches = malloc(tailleLot);
+    int *evenements = malloc(tailleLot * sizeof(int));
+    unsigned int *hasard = malloc(tailleLot * sizeof(unsigned int));
+    long *tours = malloc(tailleLot * sizeof(long));
+    pilote *pilotes = calloc(tailleLot, sizeof(pilote));
+    struct timespec debut, fin;
+    int enCours;
+    bool possible = creerLot(&leLot, tailleLot, &reglages) && (touches != NULL) && (evenements != NULL)
+                 && (hasard != NULL) && (tours != NULL) && (pilotes != NULL);
+
+    memset(total, 0, sizeof(*total));
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (int premiere = 0; possible && (premiere < nbParties); premiere += tailleLot)
+    {
+        // le dernier lot peut être incomplet
+        leLot.nombre = (nbParties - premiere < tailleLot) ? nbParties - premiere : tailleLot;
+        initLot(&leLot, graine + premiere, &reglages);
+        possible = renouvelerPilotes(pilotes, &leLot, joueur);
+        enCours = 0;
+        for (int i = 0; i < leLot.nombre; i++)
+        {
+            hasard[i] = (unsigned int)(graine + premiere + i);
+            tours[i] = 0;
+            enCours += leLot.enCours[i];
+        }
+        for (long tour = 0; possible && (tour < deplacementsMax) && (enCours > 0); tour++)
+        {
+            for (int i = 0; i < leLot.nombre; i++)
+            {
+                touches[i] = DROITE;
+                if (leLot.enCours[i])
+                {
+                    touches[i] = joueur(&leLot.parties[i], tour, &hasard[i], &pilotes[i]);
+                    tours[i]++;
+                }
+            }
+            total->deplacements += enCours;
+            enCours = avancerLot(&leLot, touches, evenements);
+            for (int i = 0; i < leLot.nombre; i++)
+            {
+                if (evenements[i] & EVENEMENT_NIVEAU)
+                {
+                    total->niveaux++;
+                }
+                if (evenements[i] & EVENEMENT_MORT)
+                {
+                    total->morts++;
+                }
+            }
+        }
+        for (int i = 0; i < leLot.nombre; i++)
+        {
+            total->pommes += leLot.parties[i].numeroPomme;
+            total->empreinte += empreintePartie(graine + premiere + i, &leLot.parties[i], tours[i]);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    total->secondes = secondesEntre(&debut, &fin);
+
+    for (int i = 0; (pilotes != NULL) && (i < tailleLot); i++)
+    {
+        detruirePilote(&pilotes[i]);
+    }
+    detruireLot(&leLot);
+    free(touches);
+    free(evenements);
+    free(hasard);
+    free(tours);
+    free(pilotes);
+    return possible;
+}
+
+bool verifierLot(agent joueur, int nbParties, uint64_t graine, long deplacementsMax)
+{
+    lot leLot;
+    partie *reference = calloc(nbParties, sizeof(partie));
+    char *touches = malloc(nbParties);
+    int *evenements = malloc(nbParties * sizeof(int));
+    int *evenementsReference = malloc(nbParties * sizeof(int));
+    unsigned int *hasard = malloc(nbParties * sizeof(unsigned int));
+    pilote *pilotes = calloc(nbParties, sizeof(pilote));
+    long long deplacements = 0;
+    int enCours = 0;
+    bool possible = creerLot(&leLot, nbParties, &reglages) && (reference != NULL) && (touches != NULL)
+                 && (evenements != NULL) && (evenementsReference != NULL) && (hasard != NULL) && (pilotes != NULL);
+    bool identique;
+
+    for (int i = 0; possible && (i < nbParties); i++)
+    {
+        possible = creerPartie(&reference[i], &reglages);
+    }
+    if (possible)
+    {
+        initLot(&leLot, graine, &reglages);
+        possible = renouvelerPilotes(pilotes, &leLot, joueur);
+    }
+    identique = possible;
+    if (possible)
+    {
+        for (int i = 0; i < nbParties; i++)
+        {
+            initPartie(&reference[i], graine + i, &reglages);
+            evenementsReference[i] = leLot.enCours[i] ? 0 : EVENEMENT_PLEIN;
+            hasard[i] = (unsigned int)(graine + i);
+            enCours += leLot.enCours[i];
+        }
+    }
+    for (long tour = 0; identique && (tour < deplacementsMax) && (enCours > 0); tour++)
+    {
+        for (int i = 0; i < nbParties; i++)
+        {
+            touches[i] = leLot.enCours[i] ? joueur(&leLot.parties[i], tour, &hasard[i], &pilotes[i]) : DROITE;
+        }
+        deplacements += enCours;
+        enCours = avancerLot(&leLot, touches, evenements);
+
+        for (int i = 0; identique && (i < nbParties); i++)
+        {
+            if ((evenementsReference[i] & EVENEMENT_FIN) == 0)
+            {
+                evenementsReference[i] = avancer(&reference[i], touches[i]);
+                if (evenementsReference[i] != evenements[i])
+                {
+                    printf("déplacement %ld, partie %d : événements %d au lieu de %d\n",
+                           tour, i, evenements[i], evenementsReference[i]);
+                    identique = false;
+                }
+            }
+            if (identique && (reference[i].cle != calculerCle(&reference[i])))
+            {
+                printf("déplacement %ld, partie %d : clé de Zobrist mal tenue à jour\n", tour, i);
+                identique = false;
+            }
+            if (identique && !memesParties(&leLot.parties[i], &reference[i]))
+            {
+                printf("déplacement %ld, partie %d : états différents\n", tour, i);
+                identique = false;
+            }
+            if (identique && ((leLot.teteX[i] != reference[i].leSerpent.lesX[reference[i].leSerpent.tete])
+                           || (leLot.teteY[i] != reference[i].leSerpent.lesY[reference[i].leSerpent.tete])
+                           || (leLot.direction[i] != reference[i].direction)))
+            {
+                printf("déplacement %ld, partie %d : tableaux du lot différents\n", tour, i);
+                identique = false;
+            }
+        }
+    }
+
+    if (!possible)
+    {
+        fprintf(stderr, "mémoire insuffisante pour %d parties\n", nbParties);
+    }
+    else if (identique)
+    {
+        printf("identique : %d parties, %lld déplacements\n", nbParties, deplacements);
+    }
+    detruireLot(&leLot);
+    for (int i = 0; (reference != NULL) && (i < nbParties); i++)
+    {
+        detruirePartie(&reference[i]);
+    }
+    for (int i = 0; (pilotes != NULL) && (i < nbParties); i++)
+    {
+        detruirePilote(&pilotes[i]);
+    }
+    free(pilotes);
+    free(reference);
+    free(touches);
+    free(evenements);
+    free(evenementsReference);
+    free(hasard);
+    return identique;
+}
+
+bool memesParties(const partie *a, const partie *b)
+{
+    bool memes = (a->nbCases == b->nbCases) && (a->largeur == b->largeur)
+              && (memcmp(a->plateau, b->plateau, a->nbCases) == 0)
+              && (memcmp(a->leSerpent.occupation, b->leSerpent.occupation, a->nbCases) == 0)
+              && (a->leSerpent.taille == b->leSerpent.taille)
+              && (a->pommeX == b->pommeX) && (a->pommeY == b->pommeY)
+              && (a->numeroPomme == b->numeroPomme) && (a->nombrePaves == b->nombrePaves)
+              && (a->tailleSerpent == b->tailleSerpent) && (a->level == b->level)
+              && (a->direction == b->direction) && (a->lesCasesLibres.nombre == b->lesCasesLibres.nombre)
+              && (a->cle == b->cle);
+
+    for (int i = 0; memes && (i < a->leSerpent.taille); i++)
+    {
+        memes = (a->leSerpent.lesX[indiceSegment(&a->leSerpent, i)] == b->leSerpent.lesX[indiceSegment(&b->leSerpent, i)])
+             && (a->leSerpent.lesY[indiceSegment(&a->leSerpent, i)] == b->leSerpent.lesY[indiceSegment(&b->leSerpent, i)]);
+    }
+    return memes;
+}
+
+void afficherResultats(const resultats *total, int nbParties)
+{
+    printf("déplacements      %lld\n", total->deplacements);
+    printf("pommes            %ld (%.1f par partie)\n", total->pommes,
+           nbParties > 0 ? (double)total->pommes / nbParties : 0.0);
+    printf("niveaux           %ld\n", total->niveaux);
+    printf("morts             %ld\n", total->morts);
+    printf("empreinte         %016" PRIx64 "\n", total->empreinte);
+    printf("durée             %.3f s\n", total->secondes);
+    if (total->secondes > 0)
+    {
+        printf("déplacements/s    %.0f\n", total->deplacements / total->secondes);
+        printf("parties/s         %.1f\n", nbParties / total->secondes);
+    }
+}
+
+void afficherPhases(const chronometrage *chrono)
+{
+    const char *noms[] = {"déplacement", "collision", "pomme", "niveau"};
+    long long temps[] = {chrono->deplacement, chrono->collision, chrono->pomme, chrono->niveau};
+    long appels[] = {chrono->nbDeplacements, chrono->nbDeplacements, chrono->nbPommes, chrono->nbNiveaux};
+
+    printf("\n%-12s %14s %10s %14s\n", "phase", "ms au total", "appels", "ns par appel");
+    for (int i = 0; i < 4; i++)
+    {
+        printf("%-12s %14.3f %10ld %14.1f\n", noms[i], temps[i] / 1e6, appels[i],
+               appels[i] > 0 ? (double)temps[i] / appels[i] : 0.0);
+    }
+    if (chrono->nbPavagesPrets > 0)
+    {
+        printf("%-12s %14.3f %10ld %14.1f\n", "niveau prêt", chrono->niveauPrets / 1e6, chrono->nbPavagesPrets,
+               (double)chrono->niveauPrets / chrono->nbPavagesPrets);
+        printf("pavages tirés d'avance : %ld sur %ld passages de niveau\n", chrono->nbPavagesPrets, chrono->nbNiveaux);
+    }
+}
+
+bool bancPaves()
+{
+    partie jeu;
+    bool statut = false;
+    bool pomme = false;
+    int nombres[] = {1, 10, 100, 1000, MAX_PAVES};
+    struct timespec debut, fin;
+    double placement;
+
+    if (!creerPartie(&jeu, &reglages))
+    {
+        fprintf(stderr, "mémoire insuffisante pour un plateau de %d x %d\n", reglages.largeur, reglages.hauteur);
+        return false;
+    }
+    printf("%10s %10s %14s %16s\n", "demandés", "posés", "µs placement", "ns/déplacement");
+    for (int n = 0; n < (int)(sizeof(nombres) / sizeof(nombres[0])); n++)
+    {
+        initPartie(&jeu, 1, &reglages);
+        clock_gettime(CLOCK_MONOTONIC, &debut);
+        initPlateau(&jeu, nombres[n]);
+        clock_gettime(CLOCK_MONOTONIC, &fin);
+        placement = secondesEntre(&debut, &fin);
+
+        // le serpent file vers la droite et traverse le téléporteur : les collisions sont ignorées
+        clock_gettime(CLOCK_MONOTONIC, &debut);
+        for (int i = 0; i < DEPLACEMENTS_PAVES; i++)
+        {
+            progresser(&jeu, DROITE, &statut, &pomme);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &fin);
+
+        printf("%10d %10d %14.1f %16.1f\n", nombres[n], jeu.nombrePaves, placement * 1e6,
+               secondesEntre(&debut, &fin) * 1e9 / DEPLACEMENTS_PAVES);
+    }
+    detruirePartie(&jeu);
+    return true;
+}
+
+bool bancCliches()
+{
+    partie jeu, rejouee;
+    cliche photo;
+    reserve laReserve;
+    unsigned int hasard = 1;
+    unsigned int hasardPhoto;
+    int evenements = 0;
+    struct timespec debut, fin;
+    double prise, restauration, restaurationChaude, priseChaude;
+    tableTransposition table;
+    long noeuds;
+    int score[2];
+    bool fidele;
+
+    if (!creerPartie(&jeu, &reglages) || !creerPartie(&rejouee, &reglages) || !creerCliche(&photo, &jeu)
+     || !creerReserve(&laReserve, RESERVE_CLICHES, &jeu) || !milieuDePartie(&jeu, &hasard))
+    {
+        fprintf(stderr, "mémoire insuffisante pour %d clichés\n", RESERVE_CLICHES);
+        detruirePartie(&jeu);
+        detruirePartie(&rejouee);
+        detruireCliche(&photo);
+        return false;
+    }
+
+    // clichés tous différents en mémoire, comme dans une recherche
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (int i = 0; i < MESURES_CLICHES; i++)
+    {
+        if (laReserve.nombre == laReserve.capacite)
+        {
+            rendreCliches(&laReserve, 0);
+        }
+        prendreCliche(&laReserve, &jeu);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    prise = secondesEntre(&debut, &fin);
+
+    // toujours le même état, qui reste dans le cache et ne change aucune case libre
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (int i = 0; i < MESURES_CLICHES; i++)
+    {
+        restaurer(&rejouee, &laReserve.cliches[i % laReserve.nombre]);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    restaurationChaude = secondesEntre(&debut, &fin);
+
+    // clichés pris tous les ECART_CLICHES déplacements de la suite de la partie, restaurés en sautant
+    // de SAUT_CLICHES en SAUT_CLICHES : deux restaurations de suite ne se ressemblent pas
+    rendreCliches(&laReserve, 0);
+    restaurer(&rejouee, &laReserve.cliches[0]);
+    hasardPhoto = hasard;
+    evenements = 0;
+    while ((laReserve.nombre < laReserve.capacite) && !(evenements & EVENEMENT_FIN))
+    {
+        prendreCliche(&laReserve, &rejouee);
+        for (int tour = 0; (tour < ECART_CLICHES) && !(evenements & EVENEMENT_FIN); tour++)
+        {
+            evenements = avancer(&rejouee, agentGlouton(&rejouee, tour, &hasardPhoto, NULL));
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (int i = 0; i < MESURES_CLICHES; i++)
+    {
+        restaurer(&rejouee, &laReserve.cliches[(int)(((long)i * SAUT_CLICHES) % laReserve.nombre)]);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    restauration = secondesEntre(&debut, &fin);
+
+    // toujours le même cliché, qui reste dans le cache
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (int i = 0; i < MESURES_CLICHES; i++)
+    {
+        photographier(&jeu, &photo);
+        __asm__ volatile("" : : "r"(&photo) : "memory");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    priseChaude = secondesEntre(&debut, &fin);
+
+    // la suite de la partie, jouée une fois depuis jeu et une fois depuis le cliché
+    photographier(&jeu, &photo);
+    hasardPhoto = hasard;
+    evenements = 0;
+    for (long tour = 0; (tour < DEPLACEMENTS_CLICHES) && !(evenements & EVENEMENT_FIN); tour++)
+    {
+        evenements = avancer(&jeu, agentGlouton(&jeu, tour, &hasard, NULL));
+    }
+    restaurer(&rejouee, &photo);
+    hasard = hasardPhoto;
+    evenements = 0;
+    for (long tour = 0; (tour < DEPLACEMENTS_CLICHES) && !(evenements & EVENEMENT_FIN); tour++)
+    {
+        evenements = avancer(&rejouee, agentGlouton(&rejouee, tour, &hasard, NULL));
+    }
+    fidele = memesParties(&jeu, &rejouee)
+          && (memcmp(jeu.hasard, rejouee.hasard, sizeof(jeu.hasard)) == 0)
+          && (rejouee.cle == calculerCle(&rejouee));
+
+    printf("taille d'un cliché       %zu octets\n", sizeof(cliche) + laReserve.tailleCliche);
+    printf("prise dans la réserve    %.1f ns (%d clichés)\n", prise * 1e9 / MESURES_CLICHES, RESERVE_CLICHES);
+    printf("prise (même cliché)      %.1f ns\n", priseChaude * 1e9 / MESURES_CLICHES);
+    printf("restauration (même état) %.1f ns\n", restaurationChaude * 1e9 / MESURES_CLICHES);
+    printf("restauration             %.1f ns (%d états, %d déplacements d'écart)\n",
+           restauration * 1e9 / MESURES_CLICHES, laReserve.nombre, ECART_CLICHES);
+    printf("partie rejouée           %s\n", fidele ? "identique" : "DIFFÉRENTE");
+
+    // exploration depuis l'état du cliché, sans puis, avec --table, avec table de transposition
+    if (!transposition || creerTable(&table, BITS_TABLE))
+    {
+        restaurer(&rejouee, &photo);
+        rendreCliches(&laReserve, 0);
+        printf("\nexploration à %d déplacements\n%-12s %10s %8s %10s\n", PROFONDEUR_RECHERCHE,
+               "table", "états", "score", "ms");
+        for (int avecTable = 0; avecTable <= (transposition ? 1 : 0); avecTable++)
+        {
+            noeuds = 0;
+            clock_gettime(CLOCK_MONOTONIC, &debut);
+            score[avecTable] = explorer(&rejouee, &laReserve, avecTable ? &table : NULL, PROFONDEUR_RECHERCHE, &noeuds);
+            clock_gettime(CLOCK_MONOTONIC, &fin);
+            printf("%-12s %10ld %8d %10.1f\n", avecTable ? "avec" : "sans", noeuds, score[avecTable],
+                   secondesEntre(&debut, &fin) * 1e3);
+        }
+        if (transposition)
+        {
+            fidele = fidele && (score[0] == score[1]);
+            detruireTable(&table);
+        }
+    }
+    detruireReserve(&laReserve);
+    detruireCliche(&photo);
+    detruirePartie(&jeu);
+    detruirePartie(&rejouee);
+    return fidele;
+}
+
+bool ouvrirNiveaux(const char *chemin, int numero)
+{
+    partie jeu;
+    parametres config;
+    struct timespec debut, fin;
+    double ouverture, chargement;
+    bool possible;
+
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    possible = ouvrirRecueil(&niveaux, chemin);
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    ouverture = secondesEntre(&debut, &fin);
+    if (!possible)
+    {
+        fprintf(stderr, "%s n'est pas un recueil de niveaux (version %d)\n", chemin, VERSION_RECUEIL);
+        return false;
+    }
+    if ((numero < 0) || (numero >= niveaux.nombre))
+    {
+        fprintf(stderr, "%s n'a pas de niveau %d (%d niveaux)\n", chemin, numero, niveaux.nombre);
+        return false;
+    }
+    reglages.largeur = niveaux.largeur;
+    reglages.hauteur = niveaux.hauteur;
+    printf("recueil %s : %d niveaux de %d x %d, ouvert en %.1f µs\n", chemin, niveaux.nombre, niveaux.largeur,
+           niveaux.hauteur, ouverture * 1e6);
+    if (!creerPartie(&jeu, &reglages))
+    {
+        fprintf(stderr, "mémoire insuffisante pour un plateau de %d x %d\n", reglages.largeur, reglages.hauteur);
+        return false;
+    }
+
+    // une nouvelle partie sur chaque niveau (première lecture de chaque page du fichier comprise), puis sur le plateau par défaut
+    config = reglages;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (int i = 0; i < niveaux.nombre; i++)
+    {
+        config.decor = decorRecueil(&niveaux, i);
+        initPartie(&jeu, 1, &config);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    chargement = secondesEntre(&debut, &fin);
+    config.decor = NULL;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (int i = 0; i < niveaux.nombre; i++)
+    {
+        initPartie(&jeu, 1, &config);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    printf("nouvelle partie    %8.2f µs sur un niveau du recueil, %.2f µs sur le plateau par défaut\n",
+           chargement * 1e6 / niveaux.nombre, secondesEntre(&debut, &fin) * 1e6 / niveaux.nombre);
+    detruirePartie(&jeu);
+
+    reglages.decor = decorRecueil(&niveaux, numero);
+    printf("niveau %d joué par toutes les parties\n", numero);
+    return true;
+}
+
+bool milieuDePartie(partie *jeu, unsigned int *hasard)
+{
+    cliche photo;
+    int evenements = 0;
+    bool possible = creerCliche(&photo, jeu);
+
+    initPartie(jeu, 1, &reglages);
+    for (long tour = 0; possible && (tour < DEPLACEMENTS_CLICHES) && !(evenements & EVENEMENT_FIN); tour++)
+    {
+        photographier(jeu, &photo);
+        evenements = avancer(jeu, agentGlouton(jeu, tour, hasard, NULL));
+    }
+    if (evenements & EVENEMENT_FIN)
+    {
+        restaurer(jeu, &photo);
+    }
+    detruireCliche(&photo);
+    return possible;
+}
+
+bool bancPlateau()
+{
+    partie jeu;
+    uint32_t *file = NULL;
+    bool *vue = NULL;
+    unsigned int hasard = 1;
+    long libres = 0;
+    long atteintes = 0;
+    int parcourues;
+    struct timespec debut, fin;
+    double parcours;
+    bool possible = creerPartie(&jeu, &reglages);
+
+    if (possible)
+    {
+        file = malloc(jeu.nbCases * sizeof(uint32_t));
+        vue = malloc(jeu.nbCases * sizeof(bool));
+    }
+    possible = possible && (file != NULL) && (vue != NULL) && milieuDePartie(&jeu, &hasard);
+    if (!possible)
+    {
+        fprintf(stderr, "mémoire insuffisante pour un plateau de %d x %d\n", reglages.largeur, reglages.hauteur);
+        detruirePartie(&jeu);
+        free(file);
+        free(vue);
+        return false;
+    }
+
+    // toutes les cases dans l'ordre de la mémoire : ligne par ligne
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (int i = 0; i < MESURES_PARCOURS; i++)
+    {
+        parcourues = 0;
+        for (uint32_t numeroCase = 0; numeroCase < jeu.nbCases; numeroCase++)
+        {
+            parcourues += (jeu.plateau[numeroCase] == AIR) & (jeu.leSerpent.occupation[numeroCase] == 0);
+        }
+        libres += parcourues;
+        __asm__ volatile("" : "+r"(libres) : : "memory");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    parcours = secondesEntre(&debut, &fin);
+    printf("parcours complet   %8.1f ns (%ld cases libres)\n", parcours * 1e9 / MESURES_PARCOURS,
+           libres / MESURES_PARCOURS);
+
+    memset(vue, false, jeu.nbCases * sizeof(bool));
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (int i = 0; i < MESURES_REMPLISSAGE; i++)
+    {
+        atteintes += remplir(&jeu, file, vue);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    printf("remplissage        %8.1f ns (%ld cases atteintes)\n",
+           secondesEntre(&debut, &fin) * 1e9 / MESURES_REMPLISSAGE, atteintes / MESURES_REMPLISSAGE);
+    detruirePartie(&jeu);
+    free(file);
+    free(vue);
+    return true;
+}
+
+int remplir(const partie *jeu, uint32_t file[], bool vue[])
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+    const int ecarts[4] = {decalage(jeu, HAUT), decalage(jeu, GAUCHE), decalage(jeu, BAS), decalage(jeu, DROITE)};
+    int debut = 0;
+    int fin = 0;
+    uint32_t courante, voisine;
+
+    file[fin++] = NUMERO_CASE(jeu, leSerpent->lesX[leSerpent->tete], leSerpent->lesY[leSerpent->tete]);
+    vue[file[0]] = true;
+    while (debut < fin)
+    {
+        courante = file[debut++];
+        for (int d = 0; d < 4; d++)
+        {
+            voisine = courante + ecarts[d];
+            if (!vue[voisine] && (jeu->plateau[voisine] == AIR) && (leSerpent->occupation[voisine] == 0))
+            {
+                vue[voisine] = true;
+                file[fin++] = voisine;
+            }
+        }
+    }
+    // seules les cases atteintes sont remises à false
+    for (int i = 0; i < fin; i++)
+    {
+        vue[file[i]] = false;
+    }
+    return fin;
+}
+
+bool bancPilote(long deplacementsMax)
+{
+    partie jeu;
+    pilote lePilote;
+    pilote chercheur;   // un pilote ne sert qu'à planifier ou qu'à piloter
+    pilote controle;    // refait les décisions de lePilote pour la passe de contrôle
+    char *touches = malloc(deplacementsMax > 0 ? deplacementsMax : 1);
+    uint32_t *file = NULL;
+    int *distance = NULL;
+    const serpent *leSerpent = &jeu.leSerpent;
+    uint32_t tete, pomme;
+    long tours = 0;
+    long ecarts = 0;
+    long controles = 0, plusLongs = 0, pasEnTrop = 0, fautes = 0;
+    long parcours, reparations, suivis;
+    int evenements;
+    int pommes = 0;
+    int court, garde;
+    struct timespec debut, fin;
+    double secondes[3];
+    bool possible = creerPartie(&jeu, &reglages);
+
+    memset(&lePilote, 0, sizeof(lePilote));
+    memset(&chercheur, 0, sizeof(chercheur));
+    memset(&controle, 0, sizeof(controle));
+    if (possible)
+    {
+        file = malloc(jeu.nbCases * sizeof(uint32_t));
+        distance = malloc(jeu.nbCases * sizeof(int));
+    }
+    possible = possible && (touches != NULL) && (file != NULL) && (distance != NULL) && creerPilote(&lePilote, &jeu)
+            && creerPilote(&chercheur, &jeu) && creerPilote(&controle, &jeu);
+    if (!possible)
+    {
+        fprintf(stderr, "mémoire insuffisante pour un plateau de %d x %d\n", reglages.largeur, reglages.hauteur);
+        detruirePartie(&jeu);
+        detruirePilote(&lePilote);
+        detruirePilote(&chercheur);
+        detruirePilote(&controle);
+        free(touches);
+        free(file);
+        free(distance);
+        return false;
+    }
+    for (uint32_t c = 0; c < jeu.nbCases; c++)
+    {
+        distance[c] = -1;
+    }
+
+    // passe 0 : planifier note les touches, écarts compris ; passe 1 : partie seule ; passe 2 : piloter en plus ;
+    // passe 3 : contrôle des chemins gardés, non mesurée
+    for (int passe = 0; passe < 4; passe++)
+    {
+        evenements = initPartie(&jeu, 1, &reglages) ? 0 : EVENEMENT_PLEIN;
+        clock_gettime(CLOCK_MONOTONIC, &debut);
+        for (long tour = 0; (tour < ((passe == 0) ? deplacementsMax : tours)) && ((evenements & EVENEMENT_FIN) == 0); tour++)
+        {
+            if (passe == 0)
+            {
+                touches[tour] = planifier(&lePilote, &jeu);
+                if ((tour % ECART_PILOTE) == ECART_PILOTE - 1)
+                {
+                    touches[tour] = ecartForce(&jeu, touches[tour]);
+                    ecarts++;
+                }
+                tours = tour + 1;
+            }
+            else if (passe == 2)
+            {
+                piloter(&chercheur, &jeu);
+            }
+            else if (passe == 3)
+            {
+                planifier(&controle, &jeu);
+                tete = NUMERO_CASE(&jeu, leSerpent->lesX[leSerpent->tete], leSerpent->lesY[leSerpent->tete]);
+                pomme = NUMERO_CASE(&jeu, jeu.pommeX, jeu.pommeY);
+                court = plusCourt(&jeu, file, distance);
+                garde = (controle.longueur > 0) ? (int)(controle.longueur - 1 - controle.etape) : -1;
+                controles++;
+                if ((court < 0) != (garde < 0))
+                {
+                    fautes++;
+                }
+                else if (garde >= 0)
+                {
+                    if ((controle.chemin[controle.etape] != tete) || (controle.chemin[controle.longueur - 1] != pomme)
+                     || (garde < court))
+                    {
+                        fautes++;
+                    }
+                    plusLongs += garde > court;
+                    pasEnTrop += garde - court;
+                }
+            }
+            evenements = avancer(&jeu, touches[tour]);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &fin);
+        if (passe < 3)
+        {
+            secondes[passe] = secondesEntre(&debut, &fin);
+        }
+        if (passe == 0)
+        {
+            pommes = jeu.numeroPomme;
+        }
+    }
+    parcours = lePilote.parcours;
+    reparations = lePilote.reparations;
+    suivis = lePilote.suivis;
+
+    printf("%ld déplacements, %d pommes, %ld écarts forcés (un tous les %d déplacements)\n",
+           tours, pommes, ecarts, ECART_PILOTE);
+    if (tours > 0)
+    {
+        printf("partie seule       %10.1f ns par déplacement\n", secondes[1] * 1e9 / tours);
+        printf("parcours complet   %10.1f ns par décision (%ld parcours)\n",
+               (secondes[2] - secondes[1]) * 1e9 / tours, tours);
+        printf("chemin réparé      %10.1f ns par décision (%ld parcours, %ld réparations, %ld pas suivis)\n",
+               (secondes[0] - secondes[1]) * 1e9 / tours, parcours, reparations, suivis);
+        printf("chemin gardé       %ld contrôles, %ld plus longs que le plus court (%ld pas de plus en tout), %ld faux\n",
+               controles, plusLongs, pasEnTrop, fautes);
+    }
+    detruirePartie(&jeu);
+    detruirePilote(&lePilote);
+    detruirePilote(&chercheur);
+    detruirePilote(&controle);
+    free(touches);
+    free(file);
+    free(distance);
+    return fautes == 0;
+}
+
+char ecartForce(const partie *jeu, char prevue)
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+    uint32_t tete = NUMERO_CASE(jeu, leSerpent->lesX[leSerpent->tete], leSerpent->lesY[leSerpent->tete]);
+    int demiTour = INDICE_DIRECTION(jeu->direction) ^ 1;
+    uint32_t voisine;
+    const char *touches = "dqzs"; // rangées par INDICE_DIRECTION
+
+    for (int i = 0; i < 4; i++)
+    {
+        voisine = jeu->destinations[tete + jeu->ecarts[i]];
+        if ((i != demiTour) && (touches[i] != prevue) && (voisine != DESTINATION_MUR) && !CASE_OCCUPEE(jeu, voisine))
+        {
+            return touches[i];
+        }
+    }
+    return prevue;
+}
+
+int plusCourt(const partie *jeu, uint32_t file[], int distance[])
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+    uint32_t tete = NUMERO_CASE(jeu, leSerpent->lesX[leSerpent->tete], leSerpent->lesY[leSerpent->tete]);
+    uint32_t pomme = NUMERO_CASE(jeu, jeu->pommeX, jeu->pommeY);
+    int demiTour = INDICE_DIRECTION(jeu->direction) ^ 1;
+    uint32_t debut = 0;
+    uint32_t fin = 0;
+    uint32_t courante, voisine;
+    int trouvee = -1;
+
+    file[fin++] = tete;
+    distance[tete] = 0;
+    while ((debut < fin) && (trouvee < 0))
+    {
+        courante = file[debut++];
+        for (int i = 0; i < 4; i++)
+        {
+            voisine = jeu->destinations[courante + jeu->ecarts[i]];
+            if (((courante != tete) || (i != demiTour)) && (voisine != DESTINATION_MUR) && (distance[voisine] < 0)
+             && !CASE_OCCUPEE(jeu, voisine))
+            {
+                distance[voisine] = distance[courante] + 1;
+                file[fin++] = voisine;
+            }
+        }
+        trouvee = distance[pomme];
+    }
+    // seules les cases atteintes sont remises à -1
+    for (uint32_t i = 0; i < fin; i++)
+    {
+        distance[file[i]] = -1;
+    }
+    return trouvee;
+}
+
+int explorer(partie *jeu, reserve *laReserve, tableTransposition *table, int profondeur, long *noeuds)
+{
+    const entreeTable *connue = (table != NULL) ? chercherTable(table, jeu->cle) : NULL;
+    uint64_t cle = jeu->cle;
+    int marque = laReserve->nombre;
+    int meilleure = jeu->numeroPomme;
+    char meilleurCoup = jeu->direction;
+    const cliche *photo;
+    int evenements, valeur;
+
+    (*noeuds)++;
+    if ((profondeur > 0) && (connue != NULL) && (connue->profondeur == profondeur))
+    {
+        meilleure = connue->valeur;
+    }
+    else if ((profondeur > 0) && ((photo = prendreCliche(laReserve, jeu)) != NULL))
+    {
+        meilleure = -1;
+        for (int i = 0; i < 4; i++)
+        {
+            if (definirDirection("zqsd"[i], jeu->direction) == "zqsd"[i])
+            {
+                evenements = avancer(jeu, "zqsd"[i]);
+                if (evenements & EVENEMENT_MORT)
+                {
+                    valeur = -1;
+                }
+                else if (evenements & EVENEMENT_FIN)
+                {
+                    valeur = jeu->numeroPomme;
+                }
+                else
+                {
+                    valeur = explorer(jeu, laReserve, table, profondeur - 1, noeuds);
+                }
+                if (valeur > meilleure)
+                {
+                    meilleure = valeur;
+                    meilleurCoup = "zqsd"[i];
+                }
+                restaurer(jeu, photo);
+            }
+        }
+        rendreCliches(laReserve, marque);
+        if (table != NULL)
+        {
+            rangerTable(table, cle, profondeur, meilleure, meilleurCoup);
+        }
+    }
+    return meilleure;
+}
+
+char agentGlouton(const partie *jeu, long tour, unsigned int *hasard, pilote *lePilote)
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+    int x = leSerpent->lesX[leSerpent->tete];
+    int y = leSerpent->lesY[leSerpent->tete];
+    char envies[4];
+    char touche = jeu->direction;
+    int nbEnvies = 0;
+
+    (void)tour;
+    (void)lePilote;
+    // Directions qui rapprochent de la pomme d'abord, puis les autres
+    if (jeu->pommeX > x)
+    {
+        envies[nbEnvies++] = DROITE;
+    }
+    if (jeu->pommeX < x)
+    {
+        envies[nbEnvies++] = GAUCHE;
+    }
+    if (jeu->pommeY > y)
+    {
+        envies[nbEnvies++] = BAS;
+    }
+    if (jeu->pommeY < y)
+    {
+        envies[nbEnvies++] = HAUT;
+    }
+    envies[nbEnvies++] = jeu->direction;
+    envies[nbEnvies++] = "zqsd"[tirage(hasard) % 4];
+
+    for (int i = nbEnvies - 1; i >= 0; i--)
+    {
+        if ((definirDirection(envies[i], jeu->direction) == envies[i]) && voisineLibre(jeu, envies[i]))
+        {
+            touche = envies[i];
+        }
+    }
+    return touche;
+}
+
+char agentAleatoire(const partie *jeu, long tour, unsigned int *hasard, pilote *lePilote)
+{
+    (void)jeu;
+    (void)tour;
+    (void)lePilote;
+    return "zqsd"[tirage(hasard) % 4];
+}
+
+char agentTouches(const partie *jeu, long tour, unsigned int *hasard, pilote *lePilote)
+{
+    (void)jeu;
+    (void)hasard;
+    (void)lePilote;
+    return toucheScript[tour % (long)strlen(toucheScript)];
+}
+
+char agentPilote(const partie *jeu, long tour, unsigned int *hasard, pilote *lePilote)
+{
+    (void)tour;
+    (void)hasard;
+    return (lePilote != NULL) ? piloter(lePilote, jeu) : jeu->direction;
+}
+
+char agentIncremental(const partie *jeu, long tour, unsigned int *hasard, pilote *lePilote)
+{
+    (void)tour;
+    (void)hasard;
+    return (lePilote != NULL) ? planifier(lePilote, jeu) : jeu->direction;
+}
+
+/*****************************************************
+ *                 BOITES A OUTILS                   *
+ *****************************************************/
+bool agentAvecPilote(agent joueur)
+{
+    return (joueur == agentPilote) || (joueur == agentIncremental);
+}
+
+bool renouvelerPilotes(pilote pilotes[], const lot *leLot, agent joueur)
+{
+    bool crees = true;
+
+    for (int i = 0; i < leLot->nombre; i++)
+    {
+        detruirePilote(&pilotes[i]);
+        crees = crees && (!agentAvecPilote(joueur) || creerPilote(&pilotes[i], &leLot->parties[i]));
+    }
+    return crees;
+}
+
+bool voisineLibre(const partie *jeu, char direction)
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+    uint32_t voisine = NUMERO_CASE(jeu, leSerpent->lesX[leSerpent->tete], leSerpent->lesY[leSerpent->tete])
+                     + decalage(jeu, direction);
+
+    // les téléporteurs sont de l'air dans le plateau, les cases de garde des bordures
+    return (jeu->plateau[voisine] == AIR) && (leSerpent->occupation[voisine] == 0);
+}
+
+int tirage(unsigned int *hasard)
+{
+    *hasard = *hasard * 1103515245 + 12345;
+    return (*hasard >> 16) & 0x7fff;
+}
+
+uint64_t empreintePartie(uint64_t graine, const partie *jeu, long deplacements)
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+    generateur melange;
+
+    // le générateur sert ici de fonction de mélange
+    initGenerateur(melange, graine ^ ((uint64_t)jeu->numeroPomme << 40) ^ ((uint64_t)deplacements << 8)
+                            ^ ((uint64_t)leSerpent->lesX[leSerpent->tete] << 32)
+                            ^ ((uint64_t)leSerpent->lesY[leSerpent->tete] << 24) ^ (uint64_t)jeu->nombrePaves);
+    return tirerGenerateur(melange);
+}
+
+double secondesEntre(const struct timespec *debut, const struct timespec *fin)
+{
+    return (fin->tv_sec - debut->tv_sec) + (fin->tv_nsec - debut->tv_nsec) / 1e9;
+}
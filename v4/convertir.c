@@ -0,0 +1,529 @@
+/**
+ * @file convertir.c
+ * @brief Convertisseur de cartes en texte vers un recueil de niveaux (niveaux.h).
+ *
+ * Une carte est dessinée avec les caractères du jeu : BORDURE ('#') pour la bordure,
+ * PAVES ('P') pour les obstacles et AIR (' ') pour le reste. Elle couvre tout le
+ * plateau, bordure comprise : la première ligne donne la largeur, le nombre de lignes
+ * la hauteur. Un fichier peut contenir plusieurs cartes séparées par une ligne vide :
+ * une ligne de la carte ouverte à gauche et à droite, sans obstacle, garde ses espaces.
+ * Les espaces de fin des autres lignes peuvent être retirés.
+ *
+ * Une ouverture dans la bordure est un téléporteur, qui répond à l'ouverture d'en
+ * face comme sur le plateau par défaut : haut et bas mènent l'un à l'autre, gauche
+ * mène à la case avant la bordure de droite, droite mène à l'ouverture de gauche.
+ *
+ * Chaque niveau est vérifié avant d'être écrit, en le chargeant dans une partie :
+ * téléporteurs appariés, serpent de départ et case devant lui libres, et toutes
+ * les cases libres atteignables depuis la tête. Une carte refusée arrête la
+ * conversion, sans recueil écrit.
+ *
+ * Avec --aleatoire, les niveaux sont tirés par le jeu lui-même (pavés de départ
+ * d'une partie de graine 1, 2, ...), pour essayer les recueils de grande taille.
+ *
+ * Utilisation : ./convertir -o recueil [-g graine] carte.txt ...
+ *               ./convertir -o recueil [-g graine] --aleatoire N [-p pavés] [--largeur N] [--hauteur N]
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "libsnake.h"
+#include "niveaux.h"
+
+/** @brief Nombre de pavés de départ des niveaux tirés par --aleatoire */
+#define PAVES_ALEATOIRES 8
+/** @brief Tirages essayés par niveau demandé avant d'abandonner --aleatoire */
+#define ESSAIS_ALEATOIRES 4
+
+/** @typedef conversion
+ * @brief Recueil en cours d'écriture et tampons de vérification, aux dimensions de son premier niveau.
+ */
+typedef struct
+{
+    FILE *fichier;    // recueil écrit
+    int largeur;      // dimensions du recueil, 0 avant le premier niveau
+    int hauteur;
+    int nombre;       // niveaux écrits
+    decor *niveau;    // niveau en cours, tailleDecor octets
+    partie jeu;       // partie où le niveau est chargé pour être vérifié
+    uint32_t *file;   // file du parcours en largeur, une case par case du plateau
+    bool *vue;        // cases déjà atteintes
+} conversion;
+
+/**
+ * @brief Alloue les tampons d'une conversion aux dimensions de son premier niveau.
+ *
+ * @param conv Conversion.
+ * @param largeur Largeur des niveaux.
+ * @param hauteur Hauteur des niveaux.
+ * @return false si les dimensions sont hors limites ou si la mémoire manque.
+ */
+bool dimensionner(conversion *conv, int largeur, int hauteur);
+
+/**
+ * @brief Lit la carte suivante d'un fichier.
+ *
+ * @param fichier Fichier de cartes.
+ * @param grille Reçoit la carte, largeur caractères par ligne (lignes courtes complétées d'AIR).
+ * @param largeur Reçoit la largeur de la carte.
+ * @param hauteur Reçoit la hauteur de la carte.
+ * @return 1 si une carte a été lue, 0 à la fin du fichier, -1 pour une carte trop grande.
+ */
+int lireCarte(FILE *fichier, char *grille, int *largeur, int *hauteur);
+
+/**
+ * @brief Caractère d'une case d'une carte lue par lireCarte.
+ *
+ * @param grille Carte.
+ * @param largeur Largeur de la carte.
+ * @param x Coordonnée X, de LARGEUR_MIN à largeur.
+ * @param y Coordonnée Y, de HAUTEUR_MIN à la hauteur.
+ * @return Caractère de la case.
+ */
+char caseCarte(const char *grille, int largeur, int x, int y);
+
+/**
+ * @brief Remplit le niveau en cours à partir d'une carte : téléporteurs et obstacles.
+ *
+ * @param conv Conversion, dimensionnée à la carte.
+ * @param grille Carte lue par lireCarte.
+ * @param graine Graine des pommes du niveau, 0 pour celle de chaque partie.
+ * @return Message d'erreur, NULL si la carte est correcte.
+ */
+const char *dessinerNiveau(conversion *conv, const char *grille, uint64_t graine);
+
+/**
+ * @brief Remplit le niveau en cours à partir des pavés de départ d'une partie.
+ *
+ * @param conv Conversion, dimensionnée.
+ * @param numero Numéro du niveau : la partie a la graine numero + 1.
+ * @param nombrePaves Nombre de pavés de départ.
+ * @param graine Graine des pommes du niveau, 0 pour celle de chaque partie.
+ */
+void tirerNiveau(conversion *conv, int numero, int nombrePaves, uint64_t graine);
+
+/**
+ * @brief Charge le niveau en cours dans une partie et vérifie qu'il est jouable.
+ *
+ * @param conv Conversion.
+ * @return Message d'erreur, NULL si le niveau est jouable.
+ */
+const char *verifierNiveau(conversion *conv);
+
+/**
+ * @brief Ajoute le niveau en cours à la fin du recueil.
+ *
+ * @param conv Conversion.
+ * @return false si l'écriture a échoué.
+ */
+bool ecrireNiveau(conversion *conv);
+
+/*****************************************************
+ *                 PROGRAMME PRINCIPALE              *
+ *****************************************************/
+int main(int argc, char *argv[])
+{
+    conversion conv;
+    enteteRecueil entete;
+    const char *sortie = NULL;
+    const char *erreur = NULL;
+    uint64_t graine = 0;
+    int aleatoires = 0;
+    int nombrePaves = PAVES_ALEATOIRES;
+    int largeur = LARGEUR_MAX;
+    int hauteur = HAUTEUR_MAX;
+    int premiereCarte = argc;
+    int lue, largeurCarte, hauteurCarte, numeroCarte;
+    char *grille;
+    FILE *cartes;
+    bool reussi;
+
+    for (int i = 1; (i < argc) && (premiereCarte == argc); i++)
+    {
+        if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+        {
+            sortie = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-g") == 0) && (i + 1 < argc))
+        {
+            graine = strtoull(argv[++i], NULL, 10);
+        }
+        else if ((strcmp(argv[i], "--aleatoire") == 0) && (i + 1 < argc))
+        {
+            aleatoires = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-p") == 0) && (i + 1 < argc))
+        {
+            nombrePaves = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--largeur") == 0) && (i + 1 < argc))
+        {
+            largeur = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--hauteur") == 0) && (i + 1 < argc))
+        {
+            hauteur = atoi(argv[++i]);
+        }
+        else if (argv[i][0] != '-')
+        {
+            premiereCarte = i;
+        }
+        else
+        {
+            sortie = NULL;
+            break;
+        }
+    }
+    if ((sortie == NULL) || ((aleatoires > 0) == (premiereCarte < argc)))
+    {
+        fprintf(stderr, "usage : %s -o recueil [-g graine] carte.txt ...\n"
+                        "        %s -o recueil [-g graine] --aleatoire N [-p pavés] [--largeur N] [--hauteur N]\n",
+                argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    memset(&conv, 0, sizeof(conv));
+    grille = malloc((size_t)DIMENSION_MAX * DIMENSION_MAX);
+    conv.fichier = fopen(sortie, "wb");
+    // l'en-tête est réécrit à la fin, avec le nombre de niveaux
+    remplirEntete(&entete, 0, 0, 0);
+    reussi = (grille != NULL) && (conv.fichier != NULL) && (fwrite(&entete, sizeof(entete), 1, conv.fichier) == 1);
+    if (!reussi)
+    {
+        fprintf(stderr, "impossible d'écrire %s\n", sortie);
+    }
+
+    if (reussi && (aleatoires > 0))
+    {
+        reussi = dimensionner(&conv, largeur, hauteur);
+        // un niveau refusé (pavés qui enferment des cases) est remplacé par le tirage suivant
+        for (int i = 0; reussi && (conv.nombre < aleatoires) && (i < ESSAIS_ALEATOIRES * aleatoires); i++)
+        {
+            tirerNiveau(&conv, i, nombrePaves, graine);
+            if (verifierNiveau(&conv) == NULL)
+            {
+                reussi = ecrireNiveau(&conv);
+            }
+        }
+        if (conv.nombre < aleatoires)
+        {
+            fprintf(stderr, "%d niveaux jouables de %d x %d avec %d pavés sur %d demandés\n",
+                    conv.nombre, largeur, hauteur, nombrePaves, aleatoires);
+            reussi = false;
+        }
+    }
+    for (int i = premiereCarte; reussi && (i < argc); i++)
+    {
+        cartes = fopen(argv[i], "r");
+        reussi = cartes != NULL;
+        if (!reussi)
+        {
+            fprintf(stderr, "impossible de lire %s\n", argv[i]);
+        }
+        numeroCarte = 0;
+        lue = reussi ? lireCarte(cartes, grille, &largeurCarte, &hauteurCarte) : 0;
+        while (reussi && (lue != 0))
+        {
+            numeroCarte++;
+            erreur = NULL;
+            if (lue < 0)
+            {
+                erreur = "carte plus grande que 4096 x 4096";
+            }
+            else if ((conv.largeur != 0) && ((largeurCarte != conv.largeur) || (hauteurCarte != conv.hauteur)))
+            {
+                erreur = "dimensions différentes de celles des cartes précédentes";
+            }
+            else if (!dimensionner(&conv, largeurCarte, hauteurCarte))
+            {
+                erreur = "dimensions hors limites ou mémoire insuffisante";
+            }
+            if (erreur == NULL)
+            {
+                erreur = dessinerNiveau(&conv, grille, graine);
+            }
+            if (erreur == NULL)
+            {
+                erreur = verifierNiveau(&conv);
+            }
+            if (erreur != NULL)
+            {
+                fprintf(stderr, "%s, carte %d (%d x %d) : %s\n", argv[i], numeroCarte, largeurCarte, hauteurCarte, erreur);
+                reussi = false;
+            }
+            reussi = reussi && ecrireNiveau(&conv);
+            lue = reussi ? lireCarte(cartes, grille, &largeurCarte, &hauteurCarte) : 0;
+        }
+        if (cartes != NULL)
+        {
+            fclose(cartes);
+        }
+    }
+
+    if (reussi)
+    {
+        remplirEntete(&entete, conv.largeur, conv.hauteur, conv.nombre);
+        reussi = (fseek(conv.fichier, 0, SEEK_SET) == 0) && (fwrite(&entete, sizeof(entete), 1, conv.fichier) == 1);
+    }
+    if (conv.fichier != NULL)
+    {
+        reussi = (fclose(conv.fichier) == 0) && reussi;
+    }
+    if (reussi)
+    {
+        printf("%s : %d niveaux de %d x %d, %zu octets par niveau\n", sortie, conv.nombre, conv.largeur, conv.hauteur,
+               tailleDecor(conv.largeur, conv.hauteur));
+    }
+    else if (conv.fichier != NULL)
+    {
+        remove(sortie);
+    }
+    detruirePartie(&conv.jeu);
+    free(conv.niveau);
+    free(conv.file);
+    free(conv.vue);
+    free(grille);
+    return reussi ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*****************************************************
+ *                 PROCEDURE                         *
+ *****************************************************/
+bool dimensionner(conversion *conv, int largeur, int hauteur)
+{
+    parametres config;
+    bool possible = conv->largeur != 0;
+
+    if (!possible)
+    {
+        parametresParDefaut(&config);
+        config.largeur = largeur;
+        config.hauteur = hauteur;
+        conv->largeur = largeur;
+        conv->hauteur = hauteur;
+        possible = creerPartie(&conv->jeu, &config);
+        if (possible)
+        {
+            conv->niveau = calloc(1, tailleDecor(largeur, hauteur));
+            conv->file = malloc(conv->jeu.nbCases * sizeof(uint32_t));
+            conv->vue = malloc(conv->jeu.nbCases * sizeof(bool));
+            possible = (conv->niveau != NULL) && (conv->file != NULL) && (conv->vue != NULL);
+        }
+    }
+    return possible;
+}
+
+int lireCarte(FILE *fichier, char *grille, int *largeur, int *hauteur)
+{
+    char ligne[DIMENSION_MAX + 3];
+    size_t longueur;
+    int lue = 0;
+    bool finCarte = false;
+
+    *largeur = 0;
+    *hauteur = 0;
+    while (!finCarte && (fgets(ligne, sizeof(ligne), fichier) != NULL))
+    {
+        longueur = strcspn(ligne, "\r\n");
+        if ((longueur == 0) && (lue != 0))
+        {
+            finCarte = true;
+        }
+        else if (longueur > 0)
+        {
+            if ((*hauteur == 0) && (longueur <= DIMENSION_MAX))
+            {
+                *largeur = (int)longueur;
+            }
+            if ((lue >= 0) && ((longueur > (size_t)*largeur) || (*hauteur >= DIMENSION_MAX) || (*largeur == 0)))
+            {
+                lue = -1;
+            }
+            else if (lue >= 0)
+            {
+                // les espaces de fin de ligne ont pu être retirés par un éditeur
+                memset(grille + (size_t)*hauteur * *largeur, AIR, *largeur);
+                memcpy(grille + (size_t)*hauteur * *largeur, ligne, longueur);
+                lue = 1;
+            }
+            (*hauteur)++;
+        }
+    }
+    return lue;
+}
+
+const char *dessinerNiveau(conversion *conv, const char *grille, uint64_t graine)
+{
+    const partie *jeu = &conv->jeu;
+    decor *niveau = conv->niveau;
+    int largeur = conv->largeur;
+    int hauteur = conv->hauteur;
+    uint32_t numeroCase;
+    char c;
+    bool bord, coin;
+    const char *erreur = NULL;
+
+    memset(niveau, 0, tailleDecor(largeur, hauteur));
+    niveau->graine = graine;
+    for (int y = HAUTEUR_MIN; (erreur == NULL) && (y <= hauteur); y++)
+    {
+        for (int x = LARGEUR_MIN; (erreur == NULL) && (x <= largeur); x++)
+        {
+            c = caseCarte(grille, largeur, x, y);
+            bord = (x == LARGEUR_MIN) || (x == largeur) || (y == HAUTEUR_MIN) || (y == hauteur);
+            coin = ((x == LARGEUR_MIN) || (x == largeur)) && ((y == HAUTEUR_MIN) || (y == hauteur));
+            numeroCase = NUMERO_CASE(jeu, x, y);
+            if ((c != BORDURE) && (c != PAVES) && (c != AIR))
+            {
+                erreur = "caractère inconnu (seuls '#', 'P' et ' ' sont permis)";
+            }
+            else if (bord && (c == PAVES))
+            {
+                erreur = "pavé dans la bordure";
+            }
+            else if (!bord && (c == BORDURE))
+            {
+                erreur = "bordure à l'intérieur du plateau (les obstacles s'écrivent 'P')";
+            }
+            else if (coin && (c == AIR))
+            {
+                erreur = "ouverture dans un coin de la bordure";
+            }
+            else if (c == PAVES)
+            {
+                niveau->obstacles[numeroCase / 64] |= (uint64_t)1 << (numeroCase % 64);
+            }
+            else if (bord && (c == AIR))
+            {
+                // l'ouverture d'en face, comme pour les téléporteurs du plateau par défaut
+                if (niveau->nombrePortails >= PORTAILS_MAX)
+                {
+                    erreur = "plus de 16 ouvertures dans la bordure";
+                }
+                else if (caseCarte(grille, largeur, (x == LARGEUR_MIN) ? largeur : ((x == largeur) ? LARGEUR_MIN : x),
+                                   (y == HAUTEUR_MIN) ? hauteur : ((y == hauteur) ? HAUTEUR_MIN : y)) != AIR)
+                {
+                    erreur = "ouverture de la bordure sans ouverture en face";
+                }
+                else if (y == HAUTEUR_MIN)
+                {
+                    niveau->portails[niveau->nombrePortails++] = (portail){numeroCase, NUMERO_CASE(jeu, x, hauteur)};
+                }
+                else if (y == hauteur)
+                {
+                    niveau->portails[niveau->nombrePortails++] = (portail){numeroCase, NUMERO_CASE(jeu, x, HAUTEUR_MIN)};
+                }
+                else if (x == LARGEUR_MIN)
+                {
+                    niveau->portails[niveau->nombrePortails++] = (portail){numeroCase, NUMERO_CASE(jeu, largeur - 1, y)};
+                }
+                else
+                {
+                    niveau->portails[niveau->nombrePortails++] = (portail){numeroCase, NUMERO_CASE(jeu, LARGEUR_MIN, y)};
+                }
+            }
+        }
+    }
+    return erreur;
+}
+
+void tirerNiveau(conversion *conv, int numero, int nombrePaves, uint64_t graine)
+{
+    const partie *jeu = &conv->jeu;
+    parametres config;
+
+    parametresParDefaut(&config);
+    config.nombrePaves = nombrePaves;
+    initPartie(&conv->jeu, (uint64_t)numero + 1, &config);
+
+    memset(conv->niveau, 0, tailleDecor(conv->largeur, conv->hauteur));
+    conv->niveau->graine = graine;
+    conv->niveau->nombrePortails = (uint32_t)jeu->nombrePortails;
+    memcpy(conv->niveau->portails, jeu->portails, sizeof(jeu->portails));
+    for (uint32_t numeroCase = 0; numeroCase < jeu->nbCases; numeroCase++)
+    {
+        if (jeu->plateau[numeroCase] == PAVES)
+        {
+            conv->niveau->obstacles[numeroCase / 64] |= (uint64_t)1 << (numeroCase % 64);
+        }
+    }
+}
+
+const char *verifierNiveau(conversion *conv)
+{
+    partie *jeu = &conv->jeu;
+    const char directions[4] = {HAUT, GAUCHE, BAS, DROITE};
+    parametres config;
+    int debut = 0;
+    int fin = 0;
+    int libres = 0;
+    int x, y;
+    uint32_t courante, voisine;
+    bool depart = true;
+
+    // le niveau est chargé comme le ferait une partie, sans pavé tiré
+    parametresParDefaut(&config);
+    config.decor = conv->niveau;
+    config.nombrePaves = 0;
+    initPartie(jeu, 1, &config);
+
+    for (int i = -1; i < TAILLE_SERPENT_INITIAL; i++)
+    {
+        // la case devant la tête (i = -1), puis chaque segment
+        depart = depart && (jeu->plateau[NUMERO_CASE(jeu, X_INITIAL(jeu->largeur) - i, Y_INITIAL(jeu->hauteur))] == AIR);
+    }
+    if (!depart)
+    {
+        return "obstacle sur le serpent de départ ou juste devant lui";
+    }
+
+    // parcours en largeur depuis la tête, téléporteurs compris ; le serpent ne bloque rien, il avance
+    memset(conv->vue, false, jeu->nbCases * sizeof(bool));
+    conv->file[fin++] = NUMERO_CASE(jeu, X_INITIAL(jeu->largeur), Y_INITIAL(jeu->hauteur));
+    conv->vue[conv->file[0]] = true;
+    while (debut < fin)
+    {
+        courante = conv->file[debut++];
+        for (int d = 0; d < 4; d++)
+        {
+            if (!prochaineTete(jeu, CASE_X(jeu, courante), CASE_Y(jeu, courante), directions[d], &x, &y))
+            {
+                voisine = NUMERO_CASE(jeu, x, y);
+                if (!conv->vue[voisine] && (jeu->plateau[voisine] == AIR))
+                {
+                    conv->vue[voisine] = true;
+                    conv->file[fin++] = voisine;
+                }
+            }
+        }
+    }
+    for (y = HAUTEUR_MIN + 1; y < jeu->hauteur; y++)
+    {
+        for (x = LARGEUR_MIN + 1; x < jeu->largeur; x++)
+        {
+            libres += (jeu->plateau[NUMERO_CASE(jeu, x, y)] == AIR) && !conv->vue[NUMERO_CASE(jeu, x, y)];
+        }
+    }
+    return (libres == 0) ? NULL : "cases libres enfermées, que le serpent ne peut pas atteindre";
+}
+
+bool ecrireNiveau(conversion *conv)
+{
+    bool ecrit = fwrite(conv->niveau, tailleDecor(conv->largeur, conv->hauteur), 1, conv->fichier) == 1;
+
+    conv->nombre += ecrit;
+    return ecrit;
+}
+
+/*****************************************************
+ *                 BOITES A OUTILS                   *
+ *****************************************************/
+char caseCarte(const char *grille, int largeur, int x, int y)
+{
+    return grille[(size_t)(y - HAUTEUR_MIN) * largeur + (x - LARGEUR_MIN)];
+}
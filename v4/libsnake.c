@@ -0,0 +1,1178 @@
+/**
+ * @file libsnake.c
+ * @brief Règles du jeu Snake (version 4) : plateau, pavés, pommes, niveaux et déplacements.
+ *
+ * Aucune entrée ni sortie : les cases modifiées sont transmises à la procédure de
+ * dessin de la partie quand elle en a une.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "libsnake.h"
+
+/** @brief Contenus qui ont une clé de Zobrist par case (ou par valeur) */
+#define ZOBRIST_PAVE 0
+#define ZOBRIST_CORPS 1
+#define ZOBRIST_TETE 2
+#define ZOBRIST_POMME 3
+#define ZOBRIST_DIRECTION 4
+#define ZOBRIST_NUMERO 5
+/** @brief Mélange de la graine du pavage d'un niveau */
+#define ZOBRIST_NIVEAU 6
+/** @brief Cases d'un ensemble comparées d'un coup par copierCases */
+#define BLOC_CASES 32
+
+/**
+ * @brief Clé de Zobrist d'un contenu sur une case.
+ *
+ * Les clés sont calculées par mélange (splitmix64) plutôt que lues dans une table :
+ * pas d'initialisation partagée entre les fils, et les clés ne changent jamais.
+ *
+ * @param contenu Un des ZOBRIST_*.
+ * @param indice Numéro de case, direction ou nombre de pommes.
+ * @return Clé sur 64 bits.
+ */
+static uint64_t cleZobrist(int contenu, int indice);
+
+/**
+ * @brief Transmet une case modifiée à la procédure de dessin de la partie, s'il y en a une.
+ *
+ * @param jeu Partie en cours.
+ * @param x Coordonnée X.
+ * @param y Coordonnée Y.
+ * @param c Nouveau caractère de la case.
+ */
+static void dessinerCase(const partie *jeu, int x, int y, char c);
+
+/**
+ * @brief Pose un pavé de coin haut gauche (x, y) : plateau, clés, cases libres, liste des pavés et dessin.
+ *
+ * @param jeu Partie qui reçoit le pavé.
+ * @param x Coordonnée X du coin.
+ * @param y Coordonnée Y du coin.
+ */
+static void poserPave(partie *jeu, int x, int y);
+
+/**
+ * @brief Dit si un pavé de coin (x, y) peut être posé sans toucher le serpent ni un autre pavé.
+ *
+ * La pomme vient d'être mangée par la tête : tester le serpent suffit.
+ *
+ * @param jeu Partie consultée.
+ * @param x Coordonnée X du coin.
+ * @param y Coordonnée Y du coin.
+ * @return true si toutes les cases du pavé sont de l'air sans serpent.
+ */
+static bool coinLibre(const partie *jeu, int x, int y);
+
+/**
+ * @brief Retire d'un ensemble de coins ceux dont le pavé chevaucherait le pavé de coin (x, y).
+ *
+ * @param jeu Partie consultée (pour ses dimensions).
+ * @param ancrages Ensemble de coins.
+ * @param x Coordonnée X du coin posé.
+ * @param y Coordonnée Y du coin posé.
+ */
+static void retirerAncrages(const partie *jeu, casesLibres *ancrages, int x, int y);
+
+/**
+ * @brief Alloue un ensemble de cases vide pour un plateau de nbCases cases.
+ *
+ * @param ensemble Ensemble à allouer.
+ * @param nbCases Nombre de cases du plateau.
+ * @return false si la mémoire manque.
+ */
+static bool allouerEnsemble(casesLibres *ensemble, uint32_t nbCases);
+
+/**
+ * @brief Range une case à un indice d'un ensemble et note sa position.
+ *
+ * @param ensemble Ensemble de cases.
+ * @param indice Indice, au plus ensemble->nombre.
+ * @param numeroCase Numéro de la case.
+ */
+static void ecrireCase(casesLibres *ensemble, uint32_t indice, uint32_t numeroCase);
+
+/**
+ * @brief Réécrit la position des cases d'indices debut à fin - 1 d'un ensemble.
+ *
+ * @param ensemble Ensemble dont les cases viennent d'être recopiées.
+ * @param debut Premier indice.
+ * @param fin Indice qui suit le dernier.
+ */
+static void ecrirePositions(casesLibres *ensemble, int debut, int fin);
+
+/**
+ * @brief Ouvre ou referme dans la table des arrivées les téléporteurs de la partie.
+ *
+ * @param jeu Partie dont la table est modifiée.
+ * @param ouverts true pour mener chaque entrée à sa sortie, false pour en refaire une bordure.
+ */
+static void marquerPortails(partie *jeu, bool ouverts);
+
+/**
+ * @brief Refait le masque des cases occupées depuis le plateau et l'occupation du serpent.
+ *
+ * @param jeu Partie dont le masque est refait.
+ */
+static void marquerOccupees(partie *jeu);
+
+/**
+ * @brief Clé de Zobrist des obstacles du décor posés dans le plateau.
+ *
+ * @param jeu Partie dont le plateau vient d'être rempli par initBordures.
+ * @return Ou exclusif des clés ZOBRIST_PAVE des obstacles, 0 sans décor.
+ */
+static uint64_t cleDecor(const partie *jeu);
+
+/**
+ * @brief Rotation à gauche d'un entier de 64 bits.
+ */
+static uint64_t rotation(uint64_t x, int k);
+
+/**
+ * @brief Lit l'horloge si la partie mesure ses phases.
+ *
+ * @param jeu Partie en cours.
+ * @return Instant en nanosecondes (CLOCK_MONOTONIC), 0 si la partie n'a pas de chronometrage.
+ */
+static long long horloge(const partie *jeu);
+
+/*****************************************************
+ *                 PROCEDURE                         *
+ *****************************************************/
+void parametresParDefaut(parametres *config)
+{
+    config->largeur = LARGEUR_MAX;
+    config->hauteur = HAUTEUR_MAX;
+    config->tailleMax = TAILLE_SERPENT_MAX;
+    config->nombrePaves = NOMBRE_PAVES_INIT;
+    config->tailleSerpent = TAILLE_SERPENT_INITIAL;
+    config->niveau = NIVEAU1;
+    config->vitesseSerpent = VITESSE_INITIAL;
+    config->dessiner = NULL;
+    config->contexte = NULL;
+    config->chrono = NULL;
+    config->commander = NULL;
+    config->livrer = NULL;
+    config->atelier = NULL;
+    config->decor = NULL;
+}
+
+bool creerPartie(partie *jeu, const parametres *config)
+{
+    parametres parDefaut;
+    size_t nbCases;
+    bool cree;
+
+    if (config == NULL)
+    {
+        parametresParDefaut(&parDefaut);
+        config = &parDefaut;
+    }
+    memset(jeu, 0, sizeof(*jeu));
+    cree = (config->largeur >= LARGEUR_PLUS_PETITE) && (config->largeur <= DIMENSION_MAX)
+        && (config->hauteur >= HAUTEUR_PLUS_PETITE) && (config->hauteur <= DIMENSION_MAX)
+        && (config->tailleMax >= TAILLE_SERPENT_INITIAL);
+    if (cree)
+    {
+        jeu->largeur = config->largeur;
+        jeu->hauteur = config->hauteur;
+        jeu->largeurLigne = config->largeur + 2;
+        jeu->nbCases = (uint32_t)jeu->largeurLigne * (uint32_t)(config->hauteur + 2);
+        nbCases = jeu->nbCases;
+        jeu->plateau = malloc(nbCases);
+        jeu->leSerpent.occupation = malloc(nbCases);
+        jeu->leSerpent.lesX = malloc(config->tailleMax * sizeof(int));
+        jeu->leSerpent.lesY = malloc(config->tailleMax * sizeof(int));
+        jeu->leSerpent.tailleMax = config->tailleMax;
+        jeu->sommes = malloc((size_t)(jeu->largeurLigne + 1) * (jeu->hauteur + 3) * sizeof(int));
+        jeu->coinsPaves = malloc(PAVES_POSSIBLES(jeu) * sizeof(uint32_t));
+        jeu->arrivees = malloc(nbCases * sizeof(uint32_t));
+        jeu->destinations = malloc(nbCases * sizeof(uint32_t));
+        jeu->occupees = calloc(MOTS_DECOR(jeu->largeur, jeu->hauteur), sizeof(uint64_t));
+        jeu->ecarts[INDICE_DIRECTION(DROITE)] = 1;
+        jeu->ecarts[INDICE_DIRECTION(GAUCHE)] = -1;
+        jeu->ecarts[INDICE_DIRECTION(BAS)] = jeu->largeurLigne;
+        jeu->ecarts[INDICE_DIRECTION(HAUT)] = -jeu->largeurLigne;
+
+        cree = (jeu->plateau != NULL) && (jeu->leSerpent.occupation != NULL) && (jeu->leSerpent.lesX != NULL)
+            && (jeu->leSerpent.lesY != NULL) && allouerEnsemble(&jeu->lesCasesLibres, nbCases)
+            && allouerEnsemble(&jeu->ancrages, nbCases) && (jeu->sommes != NULL) && (jeu->coinsPaves != NULL)
+            && (jeu->arrivees != NULL) && (jeu->destinations != NULL) && (jeu->occupees != NULL)
+            && creerPavage(&jeu->tirage, jeu);
+        if (!cree)
+        {
+            detruirePartie(jeu);
+        }
+        else
+        {
+            // table des arrivées valide dès la création : copierEtat n'y change que les téléporteurs
+            initBordures(jeu);
+        }
+    }
+    return cree;
+}
+
+void detruirePartie(partie *jeu)
+{
+    free(jeu->plateau);
+    free(jeu->leSerpent.occupation);
+    free(jeu->leSerpent.lesX);
+    free(jeu->leSerpent.lesY);
+    free(jeu->lesCasesLibres.cases);
+    free(jeu->lesCasesLibres.position);
+    free(jeu->ancrages.cases);
+    free(jeu->ancrages.position);
+    free(jeu->sommes);
+    free(jeu->coinsPaves);
+    free(jeu->arrivees);
+    free(jeu->destinations);
+    free(jeu->occupees);
+    detruirePavage(&jeu->tirage);
+    memset(jeu, 0, sizeof(*jeu));
+}
+
+void copierEtat(partie *destination, const partie *source)
+{
+    const serpent *serpentSource = &source->leSerpent;
+    serpent *serpentDestination = &destination->leSerpent;
+    int fin = serpentSource->tete + serpentSource->taille;
+    int debordement = (fin > serpentSource->tailleMax) ? fin - serpentSource->tailleMax : 0;
+
+    memcpy(destination->plateau, source->plateau, source->nbCases);
+    // les téléporteurs ne changent qu'avec le décor : la table des arrivées n'est refaite qu'alors (un cliché n'en a pas)
+    if ((destination->decor != source->decor) || (destination->nombrePortails != source->nombrePortails))
+    {
+        if (destination->arrivees != NULL)
+        {
+            marquerPortails(destination, false);
+        }
+        destination->decor = source->decor;
+        destination->nombrePortails = source->nombrePortails;
+        memcpy(destination->portails, source->portails, sizeof(source->portails));
+        if (destination->arrivees != NULL)
+        {
+            marquerPortails(destination, true);
+        }
+    }
+    memcpy(serpentDestination->occupation, serpentSource->occupation, source->nbCases);
+    memcpy(destination->occupees, source->occupees, MOTS_DECOR(source->largeur, source->hauteur) * sizeof(uint64_t));
+    // seuls les segments du serpent sont copiés, à leur place dans le tampon circulaire
+    memcpy(serpentDestination->lesX + serpentSource->tete, serpentSource->lesX + serpentSource->tete,
+           (serpentSource->taille - debordement) * sizeof(int));
+    memcpy(serpentDestination->lesY + serpentSource->tete, serpentSource->lesY + serpentSource->tete,
+           (serpentSource->taille - debordement) * sizeof(int));
+    memcpy(serpentDestination->lesX, serpentSource->lesX, debordement * sizeof(int));
+    memcpy(serpentDestination->lesY, serpentSource->lesY, debordement * sizeof(int));
+    serpentDestination->tete = serpentSource->tete;
+    serpentDestination->taille = serpentSource->taille;
+    copierCases(&destination->lesCasesLibres, &source->lesCasesLibres);
+    destination->pommeX = source->pommeX;
+    destination->pommeY = source->pommeY;
+    destination->numeroPomme = source->numeroPomme;
+    destination->nombrePaves = source->nombrePaves;
+    memcpy(destination->coinsPaves, source->coinsPaves, source->nombrePaves * sizeof(uint32_t));
+    destination->clePaves = source->clePaves;
+    destination->graine = source->graine;
+    destination->tailleSerpent = source->tailleSerpent;
+    destination->level = source->level;
+    destination->vitesseSerpent = source->vitesseSerpent;
+    destination->direction = source->direction;
+    memcpy(destination->hasard, source->hasard, sizeof(generateur));
+    destination->cle = source->cle;
+}
+
+bool initPartie(partie *jeu, uint64_t graine, const parametres *config)
+{
+    parametres parDefaut;
+    bool placee;
+
+    if (config == NULL)
+    {
+        parametresParDefaut(&parDefaut);
+        config = &parDefaut;
+    }
+    if ((config->decor != NULL) && (config->decor->graine != 0))
+    {
+        graine = config->decor->graine;
+    }
+    initGenerateur(jeu->hasard, graine);
+    jeu->graine = graine;
+    jeu->decor = config->decor;
+    jeu->dessiner = config->dessiner;
+    jeu->contexte = config->contexte;
+    jeu->chrono = config->chrono;
+    jeu->commander = config->commander;
+    jeu->livrer = config->livrer;
+    jeu->atelier = config->atelier;
+    jeu->numeroPomme = 0;
+    jeu->pommeX = 0;
+    jeu->pommeY = 0;
+    jeu->nombrePaves = 0;
+    jeu->tailleSerpent = config->tailleSerpent;
+    jeu->level = config->niveau;
+    jeu->vitesseSerpent = config->vitesseSerpent;
+    jeu->direction = DROITE;
+    initSerpent(jeu, X_INITIAL(jeu->largeur), Y_INITIAL(jeu->hauteur));
+    initPlateau(jeu, config->nombrePaves);
+    placee = ajouterPomme(jeu);
+    jeu->cle = calculerCle(jeu);
+    if (jeu->commander != NULL)
+    {
+        // le pavage du premier passage de niveau peut être tiré pendant que la partie commence
+        jeu->commander(jeu->atelier, jeu);
+    }
+    return placee;
+}
+
+int avancer(partie *jeu, char touche)
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+    char direction = definirDirection(touche, jeu->direction);
+    int x, y;
+    bool bordure;
+
+    bordure = prochaineTete(jeu, leSerpent->lesX[leSerpent->tete], leSerpent->lesY[leSerpent->tete], direction, &x, &y);
+    return appliquerDeplacement(jeu, direction, x, y, bordure);
+}
+
+int appliquerDeplacement(partie *jeu, char direction, int x, int y, bool bordure)
+{
+    bool mort = bordure;
+    bool pomme = false;
+    int level = jeu->level;
+    int evenements = 0;
+
+    deplacerSerpent(jeu, direction, x, y, &mort, &pomme);
+    if (mort)
+    {
+        evenements |= EVENEMENT_MORT;
+    }
+    if (pomme)
+    {
+        evenements |= EVENEMENT_POMME;
+        jeu->cle ^= cleZobrist(ZOBRIST_NUMERO, jeu->numeroPomme) ^ cleZobrist(ZOBRIST_NUMERO, jeu->numeroPomme + 1);
+        jeu->numeroPomme++;
+        if (!setLevel(jeu))
+        {
+            evenements |= EVENEMENT_PLEIN;
+        }
+        if (jeu->level != level)
+        {
+            evenements |= EVENEMENT_NIVEAU;
+        }
+        if (jeu->numeroPomme >= NB_POMME)
+        {
+            evenements |= EVENEMENT_VICTOIRE;
+        }
+    }
+    return evenements;
+}
+
+uint64_t calculerCle(const partie *jeu)
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+    uint64_t cle = cleZobrist(ZOBRIST_POMME, NUMERO_CASE(jeu, jeu->pommeX, jeu->pommeY))
+                 ^ cleZobrist(ZOBRIST_DIRECTION, jeu->direction)
+                 ^ cleZobrist(ZOBRIST_NUMERO, jeu->numeroPomme)
+                 ^ cleZobrist(ZOBRIST_TETE, NUMERO_CASE(jeu, leSerpent->lesX[leSerpent->tete], leSerpent->lesY[leSerpent->tete]));
+
+    for (int i = 0; i < leSerpent->taille; i++)
+    {
+        cle ^= cleZobrist(ZOBRIST_CORPS, NUMERO_CASE(jeu, leSerpent->lesX[indiceSegment(leSerpent, i)],
+                                                     leSerpent->lesY[indiceSegment(leSerpent, i)]));
+    }
+    for (uint32_t numeroCase = 0; numeroCase < jeu->nbCases; numeroCase++)
+    {
+        if (jeu->plateau[numeroCase] == PAVES)
+        {
+            cle ^= cleZobrist(ZOBRIST_PAVE, numeroCase);
+        }
+    }
+    return cle;
+}
+
+void initPlateau(partie *jeu, int nombrePaves)
+{
+    initBordures(jeu);
+    marquerOccupees(jeu);
+    initCasesLibres(jeu);
+    // ajout des pavés, autour des obstacles du décor
+    jeu->nombrePaves = 0;
+    jeu->clePaves = cleDecor(jeu);
+    initPaves(jeu, nombrePaves);
+}
+
+void initBordures(partie *jeu)
+{
+    char *plateau = jeu->plateau;
+    int largeur = jeu->largeur;
+    int hauteur = jeu->hauteur;
+    uint32_t numeroCase;
+
+    for (int col = 0; col <= hauteur + 1; col++)
+    {
+        for (int lig = 0; lig <= largeur + 1; lig++)
+        {
+            // les bordures et les cases de garde qui les entourent : la tête qui y entre s'y arrête
+            if (((lig <= LARGEUR_MIN) 
+            || (lig >= largeur)) 
+            || ((col <= HAUTEUR_MIN) 
+            || (col >= hauteur)))
+            {
+                plateau[NUMERO_CASE(jeu, lig, col)] = BORDURE;
+                jeu->arrivees[NUMERO_CASE(jeu, lig, col)] = ARRIVEE(lig, col, true);
+                jeu->destinations[NUMERO_CASE(jeu, lig, col)] = DESTINATION_MUR;
+            }
+            else
+            {
+                plateau[NUMERO_CASE(jeu, lig, col)] = AIR;
+                jeu->arrivees[NUMERO_CASE(jeu, lig, col)] = ARRIVEE(lig, col, false);
+                jeu->destinations[NUMERO_CASE(jeu, lig, col)] = NUMERO_CASE(jeu, lig, col);
+            }
+        }
+    }
+    if (jeu->decor == NULL)
+    {
+        // téléporteurs du plateau par défaut : haut et bas se répondent, gauche et droite aussi
+        jeu->portails[0] = (portail){NUMERO_CASE(jeu, largeur / 2, HAUTEUR_MIN), NUMERO_CASE(jeu, largeur / 2, hauteur)};
+        jeu->portails[1] = (portail){NUMERO_CASE(jeu, largeur / 2, hauteur), NUMERO_CASE(jeu, largeur / 2, HAUTEUR_MIN)};
+        jeu->portails[2] = (portail){NUMERO_CASE(jeu, LARGEUR_MIN, hauteur / 2), NUMERO_CASE(jeu, largeur - 1, hauteur / 2)};
+        jeu->portails[3] = (portail){NUMERO_CASE(jeu, largeur, hauteur / 2), NUMERO_CASE(jeu, LARGEUR_MIN, hauteur / 2)};
+        jeu->nombrePortails = 4;
+    }
+    else
+    {
+        // le recueil est lu sans conversion : seules les cases hors du plateau sont écartées
+        jeu->nombrePortails = 0;
+        for (uint32_t i = 0; (i < jeu->decor->nombrePortails) && (i < PORTAILS_MAX); i++)
+        {
+            if ((jeu->decor->portails[i].entree < jeu->nbCases) && (jeu->decor->portails[i].sortie < jeu->nbCases))
+            {
+                jeu->portails[jeu->nombrePortails++] = jeu->decor->portails[i];
+            }
+        }
+    }
+    for (int i = 0; i < jeu->nombrePortails; i++)
+    {
+        plateau[jeu->portails[i].entree] = AIR;
+    }
+    marquerPortails(jeu, true);
+
+    if (jeu->decor != NULL)
+    {
+        // les mots sans obstacle, les plus nombreux, sont sautés d'un coup
+        for (size_t mot = 0; mot < MOTS_DECOR(largeur, hauteur); mot++)
+        {
+            for (uint64_t bits = jeu->decor->obstacles[mot]; bits != 0; bits &= bits - 1)
+            {
+                numeroCase = (uint32_t)(mot * 64 + __builtin_ctzll(bits));
+                if ((numeroCase < jeu->nbCases) && (CASE_X(jeu, numeroCase) > LARGEUR_MIN)
+                 && (CASE_X(jeu, numeroCase) < largeur) && (CASE_Y(jeu, numeroCase) > HAUTEUR_MIN)
+                 && (CASE_Y(jeu, numeroCase) < hauteur))
+                {
+                    plateau[numeroCase] = PAVES;
+                }
+            }
+        }
+    }
+}
+
+void initPaves(partie *jeu, int nombrePaves)
+{
+    int x, y;
+    uint32_t numeroCase;
+    casesLibres *ancrages = &jeu->ancrages; // coins haut gauche où un pavé entier peut encore être posé
+
+    initAncrages(jeu, ancrages, true);
+    while ((jeu->nombrePaves < nombrePaves) && (ancrages->nombre > 0))
+    {
+        // Tirage uniforme parmi les coins encore valides
+        numeroCase = caseEnsemble(ancrages, tirerEntier(jeu->hasard, ancrages->nombre));
+        x = CASE_X(jeu, numeroCase);
+        y = CASE_Y(jeu, numeroCase);
+
+        // AJOUT DANS LE TABLEAU, puis les coins dont le rectangle chevauche ce pavé ne sont plus valides
+        poserPave(jeu, x, y);
+        retirerAncrages(jeu, ancrages, x, y);
+    }
+}
+
+bool creerPavage(pavage *tirage, const partie *modele)
+{
+    memset(tirage, 0, sizeof(*tirage));
+    tirage->coins = malloc(PAVES_POSSIBLES(modele) * sizeof(uint32_t));
+    return tirage->coins != NULL;
+}
+
+void detruirePavage(pavage *tirage)
+{
+    free(tirage->coins);
+    memset(tirage, 0, sizeof(*tirage));
+}
+
+void tirerPavage(partie *plan, uint64_t graine, int level, int nouveaux, int tailleSerpent, bool libresSeulement,
+                 pavage *tirage)
+{
+    casesLibres *ancrages = &plan->ancrages;
+    generateur hasard;
+    uint32_t numeroCase;
+    int voulus = nouveaux + MARGE_PAVAGE(tailleSerpent);
+    int libres = 0;
+
+    tirage->graine = graine;
+    tirage->level = level;
+    tirage->clePaves = plan->clePaves;
+    tirage->nombre = 0;
+    // un générateur par niveau : le tirage ne dépend pas des pommes déjà tirées
+    initGenerateur(hasard, graine ^ cleZobrist(ZOBRIST_NIVEAU, level));
+    initAncrages(plan, ancrages, false);
+    while ((tirage->nombre < voulus) && (libres < nouveaux) && (ancrages->nombre > 0))
+    {
+        numeroCase = caseEnsemble(ancrages, tirerEntier(hasard, ancrages->nombre));
+        tirage->coins[tirage->nombre++] = numeroCase;
+        retirerAncrages(plan, ancrages, CASE_X(plan, numeroCase), CASE_Y(plan, numeroCase));
+        // sans compter les coins libres, le tirage va jusqu'à voulus
+        libres += libresSeulement && coinLibre(plan, CASE_X(plan, numeroCase), CASE_Y(plan, numeroCase));
+    }
+}
+
+void poserPavage(partie *jeu, const pavage *tirage, int nombrePaves)
+{
+    int x, y;
+
+    // la marge du tirage remplace les coins recouverts par le serpent : pas de nouveau tirage ici
+    for (int i = 0; (i < tirage->nombre) && (jeu->nombrePaves < nombrePaves); i++)
+    {
+        x = CASE_X(jeu, tirage->coins[i]);
+        y = CASE_Y(jeu, tirage->coins[i]);
+        if (coinLibre(jeu, x, y))
+        {
+            poserPave(jeu, x, y);
+        }
+    }
+}
+
+void initAncrages(const partie *jeu, casesLibres *ancrages, bool avecSerpent)
+{
+    // somme[y * ligne + x] = nombre de cases bloquées (pavé ou serpent) dans le rectangle [0, x[ x [0, y[
+    int *somme = jeu->sommes;
+    int ligne = jeu->largeurLigne + 1;
+    int xInitial = X_INITIAL(jeu->largeur);
+    int yInitial = Y_INITIAL(jeu->hauteur);
+    int zoneX = ZONE_DE_PROTECTION_X(jeu->largeur);
+    int zoneY = ZONE_DE_PROTECTION_Y(jeu->hauteur);
+    int bloquees;
+
+    memset(somme, 0, ligne * sizeof(int));
+    for (int y = 0; y <= jeu->hauteur + 1; y++)
+    {
+        somme[(y + 1) * ligne] = 0;
+        for (int x = 0; x <= jeu->largeur + 1; x++)
+        {
+            somme[(y + 1) * ligne + x + 1] = somme[y * ligne + x + 1] + somme[(y + 1) * ligne + x] - somme[y * ligne + x]
+                                           + ((jeu->plateau[NUMERO_CASE(jeu, x, y)] == PAVES)
+                                           || (avecSerpent && (jeu->leSerpent.occupation[NUMERO_CASE(jeu, x, y)] > 0)));
+        }
+    }
+
+    ancrages->nombre = 0;
+    for (int y = PAVE_Y_MIN; y <= PAVE_Y_MAX(jeu->hauteur); y++)
+    {
+        for (int x = PAVE_X_MIN; x <= PAVE_X_MAX(jeu->largeur); x++)
+        {
+            // Vérification de la zone de protection = la position initiale du serpent
+            if (!((x >= xInitial - zoneX)
+            && (x <= xInitial + zoneX)
+            && (y >= yInitial - zoneY)
+            && (y <= yInitial + zoneY)))
+            {
+                bloquees = somme[(y + TAILLE_PAVES_Y) * ligne + x + TAILLE_PAVES_X] - somme[(y + TAILLE_PAVES_Y) * ligne + x]
+                         - somme[y * ligne + x + TAILLE_PAVES_X] + somme[y * ligne + x];
+                if (bloquees == 0)
+                {
+                    ajouterCase(ancrages, NUMERO_CASE(jeu, x, y));
+                }
+            }
+        }
+    }
+}
+
+void initSerpent(partie *jeu, int x, int y)
+{
+    serpent *leSerpent = &jeu->leSerpent;
+
+    memset(leSerpent->occupation, 0, jeu->nbCases);
+    // Incrémentation des coordonnées.
+    for (int i = 0; i < TAILLE_SERPENT_INITIAL; i++)
+    {
+        leSerpent->lesX[i] = x;
+        leSerpent->lesY[i] = y;
+        leSerpent->occupation[NUMERO_CASE(jeu, x, y)]++;
+        x--;
+    }
+    leSerpent->tete = 0;
+    leSerpent->taille = TAILLE_SERPENT_INITIAL;
+    marquerOccupees(jeu);
+}
+
+int indiceSegment(const serpent *leSerpent, int i)
+{
+    int indice = leSerpent->tete + i;
+
+    // tete et i sont inférieurs à tailleMax : une soustraction remplace le modulo (une division)
+    return (indice >= leSerpent->tailleMax) ? indice - leSerpent->tailleMax : indice;
+}
+
+bool ajouterPomme(partie *jeu)
+{
+    uint32_t numeroCase;
+    bool placee = false;
+
+    // Tirage uniforme parmi les cases libres, sans rejet
+    if (jeu->lesCasesLibres.nombre > 0)
+    {
+        numeroCase = caseEnsemble(&jeu->lesCasesLibres, tirerEntier(jeu->hasard, jeu->lesCasesLibres.nombre));
+        jeu->cle ^= cleZobrist(ZOBRIST_POMME, NUMERO_CASE(jeu, jeu->pommeX, jeu->pommeY)) ^ cleZobrist(ZOBRIST_POMME, numeroCase);
+        jeu->pommeX = CASE_X(jeu, numeroCase);
+        jeu->pommeY = CASE_Y(jeu, numeroCase);
+        dessinerCase(jeu, jeu->pommeX, jeu->pommeY, POMME);
+        placee = true;
+    }
+    return placee;
+}
+
+bool zonePomme(const partie *jeu, int x, int y)
+{
+    // mêmes limites que l'ancien tirage : x de 2 à largeur - 2, y de 2 à hauteur - 2
+    return (x >= 2) && (x <= jeu->largeur - 2) && (y >= 2) && (y <= jeu->hauteur - 2);
+}
+
+void initCasesLibres(partie *jeu)
+{
+    jeu->lesCasesLibres.nombre = 0;
+    for (int y = 0; y <= jeu->hauteur + 1; y++)
+    {
+        for (int x = 0; x <= jeu->largeur + 1; x++)
+        {
+            if ((jeu->plateau[NUMERO_CASE(jeu, x, y)] == AIR) && (jeu->leSerpent.occupation[NUMERO_CASE(jeu, x, y)] == 0))
+            {
+                libererCase(jeu, x, y);
+            }
+        }
+    }
+}
+
+void libererCase(partie *jeu, int x, int y)
+{
+    if (zonePomme(jeu, x, y))
+    {
+        ajouterCase(&jeu->lesCasesLibres, NUMERO_CASE(jeu, x, y));
+    }
+}
+
+void occuperCase(partie *jeu, int x, int y)
+{
+    retirerCase(&jeu->lesCasesLibres, NUMERO_CASE(jeu, x, y));
+}
+
+void ajouterCase(casesLibres *ensemble, uint32_t numeroCase)
+{
+    uint32_t indice = ensemble->court ? ((uint16_t *)ensemble->position)[numeroCase]
+                                      : ((uint32_t *)ensemble->position)[numeroCase];
+
+    if ((indice >= (uint32_t)ensemble->nombre) || (caseEnsemble(ensemble, indice) != numeroCase))
+    {
+        ecrireCase(ensemble, ensemble->nombre++, numeroCase);
+    }
+}
+
+void retirerCase(casesLibres *ensemble, uint32_t numeroCase)
+{
+    uint32_t indice = ensemble->court ? ((uint16_t *)ensemble->position)[numeroCase]
+                                      : ((uint32_t *)ensemble->position)[numeroCase];
+    uint32_t derniere;
+
+    if ((indice < (uint32_t)ensemble->nombre) && (caseEnsemble(ensemble, indice) == numeroCase))
+    {
+        // la dernière case de l'ensemble prend la place de celle qui est retirée
+        ensemble->nombre--;
+        derniere = caseEnsemble(ensemble, ensemble->nombre);
+        ecrireCase(ensemble, indice, derniere);
+    }
+}
+
+uint32_t caseEnsemble(const casesLibres *ensemble, uint32_t indice)
+{
+    return ensemble->court ? ((const uint16_t *)ensemble->cases)[indice] : ((const uint32_t *)ensemble->cases)[indice];
+}
+
+void copierCases(casesLibres *destination, const casesLibres *source)
+{
+    size_t taille = destination->court ? sizeof(uint16_t) : sizeof(uint32_t);
+    const unsigned char *numeros = source->cases;
+    unsigned char *copies = destination->cases;
+    int debut, fin;
+
+    if (destination->position == NULL)
+    {
+        // un cliché : seules les "nombre" premières cases ont un sens
+        memcpy(copies, numeros, source->nombre * taille);
+    }
+    else
+    {
+        // les cases au-delà de l'ancien nombre n'ont pas de position valable : elles sont toutes recopiées
+        for (debut = 0; debut < source->nombre; debut = fin)
+        {
+            fin = (debut + BLOC_CASES < source->nombre) ? debut + BLOC_CASES : source->nombre;
+            if ((fin > destination->nombre)
+             || (memcmp(copies + debut * taille, numeros + debut * taille, (fin - debut) * taille) != 0))
+            {
+                // le bloc entier est recopié puis ses positions réécrites, sans comparer case à case
+                memcpy(copies + debut * taille, numeros + debut * taille, (fin - debut) * taille);
+                ecrirePositions(destination, debut, fin);
+            }
+        }
+    }
+    destination->nombre = source->nombre;
+}
+
+bool setLevel(partie *jeu){
+    long long debut = horloge(jeu);
+    long long milieu;
+    bool placee;
+    bool passage = jeu->numeroPomme == jeu->level;
+    const pavage *prevu = NULL;
+    bool pret = false;
+    if(passage){
+        // le pavage tiré d'avance, s'il a été tiré pour ce passage et ces pavés, sinon tiré ici
+        prevu = (jeu->livrer != NULL) ? jeu->livrer(jeu->atelier) : NULL;
+        pret = (prevu != NULL) && (prevu->graine == jeu->graine) && (prevu->level == jeu->level)
+            && (prevu->clePaves == jeu->clePaves);
+        if (!pret)
+        {
+            tirerPavage(jeu, jeu->graine, jeu->level, jeu->nombrePaves, jeu->tailleSerpent, true, &jeu->tirage);
+            prevu = &jeu->tirage;
+        }
+        // seuls les nouveaux pavés sont placés et redessinés
+        poserPavage(jeu, prevu, jeu->nombrePaves * 2);
+        jeu->tailleSerpent++;
+        jeu->vitesseSerpent = jeu->vitesseSerpent * ACCELERATION;
+        jeu->level = jeu->level * 2;
+        if (jeu->commander != NULL)
+        {
+            // la commande du pavage suivant fait partie du passage de niveau et de sa mesure
+            jeu->commander(jeu->atelier, jeu);
+        }
+    }
+    milieu = horloge(jeu);
+    placee = ajouterPomme(jeu);
+    if (jeu->chrono != NULL)
+    {
+        if (passage)
+        {
+            jeu->chrono->niveau += milieu - debut;
+            jeu->chrono->nbNiveaux++;
+        }
+        if (pret)
+        {
+            jeu->chrono->niveauPrets += milieu - debut;
+            jeu->chrono->nbPavagesPrets++;
+        }
+        jeu->chrono->pomme += horloge(jeu) - milieu;
+        jeu->chrono->nbPommes++;
+    }
+    return placee;
+}
+
+bool teteTouchePomme(const partie *jeu)
+{
+    bool pommeToucher = false;
+    const serpent *leSerpent = &jeu->leSerpent;
+    // Vérifier la collision avec la pomme actuelle uniquement
+    if ((leSerpent->lesX[leSerpent->tete] == jeu->pommeX) && (leSerpent->lesY[leSerpent->tete] == jeu->pommeY))
+    {
+        pommeToucher = true;
+    }
+    return pommeToucher;
+}
+
+char definirDirection(char touche, char direction)
+{
+    /**@brief Fonction permettant de modifier la direction de déplacement du serpent .*/
+
+    if (touche == HAUT && direction != BAS) // Récupération de la nouvelle valeur et de l'ancienne
+    {
+        direction = HAUT; // assignation
+    }
+    else if ((touche == BAS) && (direction != HAUT)) // Récupération de la nouvelle valeur et de l'ancienne
+    {
+        direction = BAS; // assignation
+    }
+    else if ((touche == GAUCHE) && (direction != DROITE)) // Récupération de la nouvelle valeur et de l'ancienne
+    {
+        direction = GAUCHE; // assignation
+    }
+    else if ((touche == DROITE) && (direction != GAUCHE)) // Récupération de la nouvelle valeur et de l'ancienne
+    {
+        direction = DROITE; // assignation
+    }
+    return direction;
+}
+bool prochaineTete(const partie *jeu, int x, int y, char direction, int *nouveauX, int *nouveauY)
+{
+    // une seule lecture : la voisine, ou la sortie du téléporteur, et la bordure
+    uint32_t arrivee = jeu->arrivees[NUMERO_CASE(jeu, x, y) + jeu->ecarts[INDICE_DIRECTION(direction)]];
+
+    *nouveauX = ARRIVEE_X(arrivee);
+    *nouveauY = ARRIVEE_Y(arrivee);
+    return (arrivee & ARRIVEE_MUR) != 0;
+}
+void deplacerSerpent(partie *jeu, char direction, int x, int y, bool *statut, bool *pomme)
+{
+    serpent *leSerpent = &jeu->leSerpent;
+    char tete;
+    int ancienneTete = leSerpent->tete;
+    int queue;
+    uint32_t caseQueue;
+    uint32_t caseTete = NUMERO_CASE(jeu, x, y);
+    long long debut = horloge(jeu);
+    long long milieu;
+
+    // La queue recule, sauf si le serpent n'a pas encore atteint sa taille
+    if ((leSerpent->taille < jeu->tailleSerpent) && (leSerpent->taille < leSerpent->tailleMax))
+    {
+        leSerpent->taille++;
+    }
+    else
+    {
+        queue = indiceSegment(leSerpent, leSerpent->taille - 1);
+        caseQueue = NUMERO_CASE(jeu, leSerpent->lesX[queue], leSerpent->lesY[queue]);
+        jeu->cle ^= cleZobrist(ZOBRIST_CORPS, caseQueue);
+        leSerpent->occupation[caseQueue]--;
+        if ((leSerpent->occupation[caseQueue] == 0) && (jeu->plateau[caseQueue] != PAVES))
+        {
+            jeu->occupees[caseQueue >> 6] &= ~(UINT64_C(1) << (caseQueue & 63));
+        }
+        if ((leSerpent->occupation[caseQueue] == 0) && (jeu->plateau[caseQueue] == AIR))
+        {
+            libererCase(jeu, leSerpent->lesX[queue], leSerpent->lesY[queue]);
+        }
+        dessinerCase(jeu, leSerpent->lesX[queue], leSerpent->lesY[queue], AIR);
+    }
+
+    switch (direction)
+    {
+    case DROITE:
+        tete = TDROITE;
+        break;
+    case GAUCHE:
+        tete = TGAUCHE;
+        break;
+    case BAS:
+        tete = TBAS;
+        break;
+    default:
+        tete = THAUT;
+        break;
+    }
+    jeu->cle ^= cleZobrist(ZOBRIST_DIRECTION, jeu->direction) ^ cleZobrist(ZOBRIST_DIRECTION, direction)
+              ^ cleZobrist(ZOBRIST_TETE, NUMERO_CASE(jeu, leSerpent->lesX[ancienneTete], leSerpent->lesY[ancienneTete]))
+              ^ cleZobrist(ZOBRIST_TETE, caseTete) ^ cleZobrist(ZOBRIST_CORPS, caseTete);
+    jeu->direction = direction;
+
+    // La nouvelle tête est écrite juste avant l'ancienne dans le tampon circulaire
+    leSerpent->tete = (ancienneTete == 0) ? leSerpent->tailleMax - 1 : ancienneTete - 1;
+    leSerpent->lesX[leSerpent->tete] = x;
+    leSerpent->lesY[leSerpent->tete] = y;
+    milieu = horloge(jeu);
+
+    // Collision avec le serpent : la queue a déjà libéré sa case, la tête n'est pas encore comptée
+    if (leSerpent->occupation[caseTete] > 0)
+    {
+        *statut = true;
+    }
+    leSerpent->occupation[caseTete]++;
+    jeu->occupees[caseTete >> 6] |= UINT64_C(1) << (caseTete & 63);
+    occuperCase(jeu, x, y);
+
+    // Collision avec les pavés : le plateau connaît déjà le contenu de chaque case
+    if (jeu->plateau[caseTete] == PAVES)
+    {
+        *statut = true;
+    }
+
+    // Gestion des pommes
+    *pomme = teteTouchePomme(jeu);
+    if (*pomme)
+    {
+        // Effacer la pomme mangée sur le plateau
+        dessinerCase(jeu, jeu->pommeX, jeu->pommeY, AIR);
+    }
+
+    // Seules l'ancienne tête (devenue corps) et la nouvelle tête changent à l'écran
+    dessinerCase(jeu, leSerpent->lesX[ancienneTete], leSerpent->lesY[ancienneTete], CORPS);
+    dessinerCase(jeu, x, y, tete);
+
+    if (jeu->chrono != NULL)
+    {
+        jeu->chrono->deplacement += milieu - debut;
+        jeu->chrono->collision += horloge(jeu) - milieu;
+        jeu->chrono->nbDeplacements++;
+    }
+}
+
+void progresser(partie *jeu, char direction, bool *statut, bool *pomme)
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+    int x, y;
+
+    *statut = prochaineTete(jeu, leSerpent->lesX[leSerpent->tete], leSerpent->lesY[leSerpent->tete], direction, &x, &y);
+    deplacerSerpent(jeu, direction, x, y, statut, pomme);
+}
+
+/*****************************************************
+ *                 BOITES A OUTILS                   *
+ *****************************************************/
+void initGenerateur(generateur hasard, uint64_t graine)
+{
+    uint64_t z;
+
+    // splitmix64 : chaque mot de l'état est une graine bien mélangée
+    for (int i = 0; i < 4; i++)
+    {
+        graine += 0x9e3779b97f4a7c15ULL;
+        z = graine;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        hasard[i] = z ^ (z >> 31);
+    }
+}
+
+uint64_t tirerGenerateur(generateur hasard)
+{
+    uint64_t resultat = rotation(hasard[1] * 5, 7) * 9;
+    uint64_t t = hasard[1] << 17;
+
+    hasard[2] ^= hasard[0];
+    hasard[3] ^= hasard[1];
+    hasard[1] ^= hasard[2];
+    hasard[0] ^= hasard[3];
+    hasard[2] ^= t;
+    hasard[3] = rotation(hasard[3], 45);
+    return resultat;
+}
+
+int tirerEntier(generateur hasard, int borne)
+{
+    // les 32 bits hauts ramenés à [0, borne[ par multiplication, sans division
+    return (int)(((tirerGenerateur(hasard) >> 32) * (uint64_t)borne) >> 32);
+}
+
+int decalage(const partie *jeu, char direction)
+{
+    int ecart;
+
+    switch (direction)
+    {
+    case DROITE:
+        ecart = 1;
+        break;
+    case GAUCHE:
+        ecart = -1;
+        break;
+    case BAS:
+        ecart = jeu->largeurLigne;
+        break;
+    default:
+        ecart = -jeu->largeurLigne;
+        break;
+    }
+    return ecart;
+}
+
+static void poserPave(partie *jeu, int x, int y)
+{
+    uint32_t numeroCase;
+    uint64_t cle;
+
+    for (int dx = 0; dx < TAILLE_PAVES_X; dx++)
+    {
+        for (int dy = 0; dy < TAILLE_PAVES_Y; dy++)
+        {
+            numeroCase = NUMERO_CASE(jeu, dx + x, dy + y);
+            cle = cleZobrist(ZOBRIST_PAVE, numeroCase);
+            jeu->plateau[numeroCase] = PAVES;
+            jeu->occupees[numeroCase >> 6] |= UINT64_C(1) << (numeroCase & 63);
+            jeu->cle ^= cle;
+            jeu->clePaves ^= cle;
+            occuperCase(jeu, dx + x, dy + y);
+            dessinerCase(jeu, dx + x, dy + y, PAVES);
+        }
+    }
+    jeu->coinsPaves[jeu->nombrePaves++] = NUMERO_CASE(jeu, x, y);
+}
+
+static bool coinLibre(const partie *jeu, int x, int y)
+{
+    bool libre = true;
+
+    for (int dy = 0; libre && (dy < TAILLE_PAVES_Y); dy++)
+    {
+        for (int dx = 0; libre && (dx < TAILLE_PAVES_X); dx++)
+        {
+            libre = (jeu->plateau[NUMERO_CASE(jeu, x + dx, y + dy)] == AIR)
+                 && (jeu->leSerpent.occupation[NUMERO_CASE(jeu, x + dx, y + dy)] == 0);
+        }
+    }
+    return libre;
+}
+
+static void retirerAncrages(const partie *jeu, casesLibres *ancrages, int x, int y)
+{
+    for (int ax = x - TAILLE_PAVES_X + 1; ax < x + TAILLE_PAVES_X; ax++)
+    {
+        for (int ay = y - TAILLE_PAVES_Y + 1; ay < y + TAILLE_PAVES_Y; ay++)
+        {
+            if ((ax >= PAVE_X_MIN) && (ax <= PAVE_X_MAX(jeu->largeur))
+             && (ay >= PAVE_Y_MIN) && (ay <= PAVE_Y_MAX(jeu->hauteur)))
+            {
+                retirerCase(ancrages, NUMERO_CASE(jeu, ax, ay));
+            }
+        }
+    }
+}
+
+static bool allouerEnsemble(casesLibres *ensemble, uint32_t nbCases)
+{
+    ensemble->court = INDICES_COURTS(nbCases);
+    ensemble->nombre = 0;
+    ensemble->cases = malloc(nbCases * TAILLE_INDICE(nbCases));
+    // positions lues avant d'être écrites par le premier ajout : à zéro plutôt qu'indéterminées
+    ensemble->position = calloc(nbCases, TAILLE_INDICE(nbCases));
+    return (ensemble->cases != NULL) && (ensemble->position != NULL);
+}
+
+static void ecrireCase(casesLibres *ensemble, uint32_t indice, uint32_t numeroCase)
+{
+    if (ensemble->court)
+    {
+        ((uint16_t *)ensemble->cases)[indice] = (uint16_t)numeroCase;
+        ((uint16_t *)ensemble->position)[numeroCase] = (uint16_t)indice;
+    }
+    else
+    {
+        ((uint32_t *)ensemble->cases)[indice] = numeroCase;
+        ((uint32_t *)ensemble->position)[numeroCase] = indice;
+    }
+}
+
+static void ecrirePositions(casesLibres *ensemble, int debut, int fin)
+{
+    if (ensemble->court)
+    {
+        const uint16_t *cases = ensemble->cases;
+        uint16_t *position = ensemble->position;
+
+        for (int i = debut; i < fin; i++)
+        {
+            position[cases[i]] = (uint16_t)i;
+        }
+    }
+    else
+    {
+        const uint32_t *cases = ensemble->cases;
+        uint32_t *position = ensemble->position;
+
+        for (int i = debut; i < fin; i++)
+        {
+            position[cases[i]] = (uint32_t)i;
+        }
+    }
+}
+
+static void marquerOccupees(partie *jeu)
+{
+    memset(jeu->occupees, 0, MOTS_DECOR(jeu->largeur, jeu->hauteur) * sizeof(uint64_t));
+    for (uint32_t numeroCase = 0; numeroCase < jeu->nbCases; numeroCase++)
+    {
+        if ((jeu->plateau[numeroCase] == PAVES) || (jeu->leSerpent.occupation[numeroCase] > 0))
+        {
+            jeu->occupees[numeroCase >> 6] |= UINT64_C(1) << (numeroCase & 63);
+        }
+    }
+}
+
+static void marquerPortails(partie *jeu, bool ouverts)
+{
+    uint32_t entree, sortie;
+
+    for (int i = 0; i < jeu->nombrePortails; i++)
+    {
+        entree = jeu->portails[i].entree;
+        sortie = ouverts ? jeu->portails[i].sortie : entree;
+        jeu->arrivees[entree] = ARRIVEE(CASE_X(jeu, sortie), CASE_Y(jeu, sortie), !ouverts);
+        jeu->destinations[entree] = ouverts ? sortie : DESTINATION_MUR;
+    }
+}
+
+static uint64_t cleDecor(const partie *jeu)
+{
+    uint64_t cle = 0;
+    uint32_t numeroCase;
+
+    for (size_t mot = 0; (jeu->decor != NULL) && (mot < MOTS_DECOR(jeu->largeur, jeu->hauteur)); mot++)
+    {
+        for (uint64_t bits = jeu->decor->obstacles[mot]; bits != 0; bits &= bits - 1)
+        {
+            numeroCase = (uint32_t)(mot * 64 + __builtin_ctzll(bits));
+            // les obstacles écartés par initBordures ne sont pas dans le plateau
+            if ((numeroCase < jeu->nbCases) && (jeu->plateau[numeroCase] == PAVES))
+            {
+                cle ^= cleZobrist(ZOBRIST_PAVE, numeroCase);
+            }
+        }
+    }
+    return cle;
+}
+
+static uint64_t cleZobrist(int contenu, int indice)
+{
+    uint64_t z = ((uint64_t)contenu << 32 | (uint32_t)indice) * 0x9e3779b97f4a7c15ULL + 0x2545f4914f6cdd1dULL;
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static uint64_t rotation(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+static void dessinerCase(const partie *jeu, int x, int y, char c)
+{
+    if (jeu->dessiner != NULL)
+    {
+        jeu->dessiner(jeu->contexte, x, y, c);
+    }
+}
+
+static long long horloge(const partie *jeu)
+{
+    struct timespec instant;
+    long long nanosecondes = 0;
+
+    if (jeu->chrono != NULL)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &instant);
+        nanosecondes = (long long)instant.tv_sec * 1000000000 + instant.tv_nsec;
+    }
+    return nanosecondes;
+}
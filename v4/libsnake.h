@@ -0,0 +1,754 @@
+/**
+ * @file libsnake.h
+ * @brief Règles du jeu Snake (version 4), sans saisie ni affichage.
+ *
+ * Une partie avance d'un déplacement à chaque appel de avancer(), qui renvoie les
+ * événements du déplacement. Le dessin passe par une procédure facultative donnée
+ * dans les paramètres : sans elle, la partie tourne sans terminal et sans attente.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#ifndef LIBSNAKE_H
+#define LIBSNAKE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @defgroup Constantes Constantes du jeu */
+/**@{*/
+
+/** @brief Coordonnée X de la bordure gauche */
+#define LARGEUR_MIN 1
+/** @brief Coordonnée Y de la bordure du haut */
+#define HAUTEUR_MIN 1
+/** @brief Largeur de l'aire de jeu par défaut (coordonnée X de la bordure droite) */
+#define LARGEUR_MAX 80
+/** @brief Hauteur de l'aire de jeu par défaut (coordonnée Y de la bordure du bas) */
+#define HAUTEUR_MAX 40
+/** @brief Plus grande largeur ou hauteur acceptée par creerPartie */
+#define DIMENSION_MAX 4096
+/** @brief Plus petite largeur acceptée : le serpent initial et un pavé hors zone de protection tiennent */
+#define LARGEUR_PLUS_PETITE 24
+/** @brief Plus petite hauteur acceptée */
+#define HAUTEUR_PLUS_PETITE 12
+/** @brief Taille d'un pavé en X*/
+#define TAILLE_PAVES_X 6
+/** @brief Taille d'un pavé en Y*/
+#define TAILLE_PAVES_Y 4
+/** @brief Nombre de pavés */
+#define NOMBRE_PAVES_INIT 1
+/** @brief Nombre max de pavés autorisés */
+#define MAX_PAVES 10000
+/** @brief Caractère pour représenter les bordures */
+#define BORDURE '#'
+/** @brief Caractère pour représenter les pavés*/
+#define PAVES 'P'
+/** @brief Caractère pour représenter le vide */
+#define AIR ' '
+/** @brief Zone de protection horizontale autour du serpent : 3/16 de la largeur (15 cases sur 80) */
+#define ZONE_DE_PROTECTION_X(largeur) ((largeur) * 3 / 16)
+/** @brief Zone de protection verticale autour du serpent : 1/8 de la hauteur (5 cases sur 40) */
+#define ZONE_DE_PROTECTION_Y(hauteur) ((hauteur) / 8)
+/** @brief Coordonnée X minimale du coin haut gauche d'un pavé */
+#define PAVE_X_MIN 3
+/** @brief Coordonnée X maximale du coin haut gauche d'un pavé */
+#define PAVE_X_MAX(largeur) ((largeur) - TAILLE_PAVES_X - 1)
+/** @brief Coordonnée Y minimale du coin haut gauche d'un pavé */
+#define PAVE_Y_MIN 3
+/** @brief Coordonnée Y maximale du coin haut gauche d'un pavé */
+#define PAVE_Y_MAX(hauteur) ((hauteur) - TAILLE_PAVES_Y - 1)
+/** @brief Nombre de pavés qui tiennent au plus sur le plateau d'une partie */
+#define PAVES_POSSIBLES(jeu) ((jeu)->nbCases / (TAILLE_PAVES_X * TAILLE_PAVES_Y) + 1)
+/** @brief Coins tirés en plus des nouveaux pavés d'un niveau : les coins tirés ne se chevauchent pas,
+ *         chaque segment du serpent en recouvre au plus un */
+#define MARGE_PAVAGE(tailleSerpent) (tailleSerpent)
+/** @brief Nombre maximum de téléporteurs d'un plateau (une entrée par ouverture de la bordure) */
+#define PORTAILS_MAX 16
+/** @brief Nombre de mots de 64 bits du masque des obstacles d'un décor : un bit par case, cases de garde comprises */
+#define MOTS_DECOR(largeur, hauteur) (((size_t)((largeur) + 2) * (size_t)((hauteur) + 2) + 63) / 64)
+
+/** @brief Caractère pour représenter la pomme */
+#define POMME '6'
+/** @brief Nombre de pomme dans le jeu */
+#define NB_POMME 1500
+#define NIVEAU1 3
+
+
+/** @brief Position initiale X du serpent : le milieu de la largeur */
+#define X_INITIAL(largeur) ((largeur) / 2)
+/** @brief Position initiale Y du serpent : le milieu de la hauteur */
+#define Y_INITIAL(hauteur) ((hauteur) / 2)
+/** @brief Vitesse initial */
+#define VITESSE_INITIAL 800000
+
+/** @brief Caractère pour représenter la tête du serpent */
+#define TDROITE '>'
+#define TGAUCHE '<'
+#define THAUT '^'
+#define TBAS 'v'
+/** @brief Caractère pour représenter le corps du serpent */
+#define CORPS 'X'
+/** @brief Taille maximum du serpent par défaut */
+#define TAILLE_SERPENT_MAX 20
+/** @brief Taille initiale du serpent */
+#define TAILLE_SERPENT_INITIAL 10
+/** @brief Vitesse de déplacement en microsecondes */
+#define ACCELERATION 0.9
+
+/** @brief Touche pour aller en haut */
+#define HAUT 'z'
+/** @brief Touche pour aller en bas */
+#define BAS 's'
+/** @brief Touche pour aller à gauche */
+#define GAUCHE 'q'
+/** @brief Touche pour aller à droite */
+#define DROITE 'd'
+
+/** @brief Événement : la pomme a été mangée */
+#define EVENEMENT_POMME 1
+/** @brief Événement : passage au niveau suivant */
+#define EVENEMENT_NIVEAU 2
+/** @brief Événement : collision, la partie est perdue */
+#define EVENEMENT_MORT 4
+/** @brief Événement : plus aucune case libre pour la pomme */
+#define EVENEMENT_PLEIN 8
+/** @brief Événement : NB_POMME pommes ont été mangées */
+#define EVENEMENT_VICTOIRE 16
+/** @brief Événements qui terminent la partie */
+#define EVENEMENT_FIN (EVENEMENT_MORT | EVENEMENT_PLEIN | EVENEMENT_VICTOIRE)
+
+/** @brief Numéro de la case (x, y) d'une partie : indice dans son plateau, rangé ligne par ligne */
+#define NUMERO_CASE(jeu, x, y) ((uint32_t)(y) * (uint32_t)(jeu)->largeurLigne + (uint32_t)(x))
+/** @brief Coordonnée X d'un numéro de case */
+#define CASE_X(jeu, numeroCase) ((int)((numeroCase) % (uint32_t)(jeu)->largeurLigne))
+/** @brief Coordonnée Y d'un numéro de case */
+#define CASE_Y(jeu, numeroCase) ((int)((numeroCase) / (uint32_t)(jeu)->largeurLigne))
+/** @brief Numéros et indices d'un ensemble de cases sur 16 bits pour un plateau de nbCases cases */
+#define INDICES_COURTS(nbCases) ((nbCases) <= UINT16_MAX)
+/** @brief Octets d'un numéro ou d'un indice d'un ensemble de cases */
+#define TAILLE_INDICE(nbCases) (INDICES_COURTS(nbCases) ? sizeof(uint16_t) : sizeof(uint32_t))
+/** @brief Indice d'une direction dans partie->ecarts : les deux derniers bits de 'd', 'q', 'z' et 's' valent 0, 1, 2 et 3 */
+#define INDICE_DIRECTION(direction) ((unsigned char)(direction) & 3)
+/** @brief Bit d'une arrivée qui signale une bordure (x et y tiennent sur 13 bits) */
+#define ARRIVEE_MUR 0x8000u
+/** @brief Arrivée de la tête en (x, y), avec ou sans bordure, rangée dans partie->arrivees */
+#define ARRIVEE(x, y, mur) ((uint32_t)(x) | ((uint32_t)(y) << 16) | ((mur) ? ARRIVEE_MUR : 0u))
+/** @brief Coordonnée X d'une arrivée */
+#define ARRIVEE_X(arrivee) ((int)((arrivee) & 0x7fffu))
+/** @brief Coordonnée Y d'une arrivée */
+#define ARRIVEE_Y(arrivee) ((int)((arrivee) >> 16))
+/** @brief Destination d'une case dont l'entrée arrête la tête, rangée dans partie->destinations */
+#define DESTINATION_MUR UINT32_MAX
+/** @brief Vrai si un pavé ou un segment du serpent occupe la case, lu dans partie->occupees */
+#define CASE_OCCUPEE(jeu, numeroCase) (((jeu)->occupees[(numeroCase) >> 6] >> ((numeroCase) & 63)) & 1u)
+
+/** @typedef generateur
+ * @brief État du générateur pseudo-aléatoire xoshiro256** d'une partie.
+ */
+typedef uint64_t generateur[4];
+
+/** @typedef serpent
+ * @brief Corps du serpent rangé dans un tampon circulaire.
+ *
+ * Le segment i (0 pour la tête) se trouve à l'indice (tete + i) % tailleMax :
+ * avancer revient à écrire une nouvelle tête avant l'ancienne, sans décaler le corps.
+ */
+typedef struct
+{
+    int *lesX;                // coordonnées X des segments, tailleMax cases
+    int *lesY;                // coordonnées Y des segments
+    int tete;                 // indice de la tête dans le tampon
+    int taille;               // nombre de segments dans le tampon
+    int tailleMax;            // taille du tampon
+    unsigned char *occupation; // nombre de segments sur chaque case, rangé comme le plateau
+} serpent;
+
+/** @typedef casesLibres
+ * @brief Ensemble de cases : cases où une pomme peut apparaître, ou coins où un pavé peut être posé.
+ *
+ * Les numéros de case sont rangés sans trou dans "cases" ; "position" donne l'indice
+ * de chaque case dans ce tableau. Une case est dans l'ensemble si cases[position[c]]
+ * vaut c avant "nombre" : la position des autres cases n'a pas à être effacée et se
+ * recalcule depuis "cases" seul (copierCases). Ajouter, retirer ou tirer une case
+ * au hasard se fait en temps constant.
+ *
+ * Sur un plateau d'au plus 65535 cases (INDICES_COURTS), numéros et indices tiennent
+ * sur 16 bits : l'ensemble est deux fois plus petit à parcourir et à copier.
+ */
+typedef struct
+{
+    void *cases;        // numéros des cases de l'ensemble, une case par case du plateau
+    void *position;     // indice de chaque case dans "cases", valable pour les cases de l'ensemble
+    int nombre;         // nombre de cases dans l'ensemble
+    bool court;         // uint16_t dans cases et position, uint32_t sinon
+} casesLibres;
+
+/** @typedef dessinateur
+ * @brief Procédure appelée pour chaque case dont le contenu change à l'écran.
+ *
+ * @param contexte Pointeur donné dans les paramètres de la partie.
+ * @param x Coordonnée X.
+ * @param y Coordonnée Y.
+ * @param c Nouveau caractère de la case.
+ */
+typedef void (*dessinateur)(void *contexte, int x, int y, char c);
+
+/** @typedef portail
+ * @brief Téléporteur : une ouverture de la bordure et la case où elle mène.
+ */
+typedef struct
+{
+    uint32_t entree; // numéro de la case d'ouverture, dans la bordure
+    uint32_t sortie; // numéro de la case où arrive la tête
+} portail;
+
+/** @typedef decor
+ * @brief Plateau dessiné à l'avance : téléporteurs, obstacles et suite des pommes.
+ *
+ * Un décor est rangé tel quel dans un recueil de niveaux (niveaux.h) et lu sans
+ * conversion. Il n'a de sens qu'aux dimensions du recueil : la partie qui le joue
+ * doit avoir été créée à ces dimensions. Les obstacles sont posés comme des pavés.
+ */
+typedef struct
+{
+    uint64_t graine;                // graine des pavés et des pommes, 0 pour garder celle de la partie
+    uint32_t nombrePortails;        // entrées utilisées de portails
+    uint32_t reserve;               // 0, garde obstacles aligné sur 8 octets
+    portail portails[PORTAILS_MAX];
+    uint64_t obstacles[];           // bit NUMERO_CASE à 1 pour un obstacle, MOTS_DECOR mots
+} decor;
+
+/** @typedef pavage
+ * @brief Coins des pavés d'un passage de niveau, tirés sans tenir compte du serpent.
+ *
+ * Le tirage ne dépend que de la graine de la partie, du niveau et des pavés déjà
+ * posés (clePaves) : il peut être fait d'avance, par un autre fil, et donne le même
+ * résultat que s'il était fait au passage de niveau.
+ */
+typedef struct
+{
+    uint64_t graine;   // graine de la partie
+    int level;         // valeur de jeu->level au passage de niveau
+    uint64_t clePaves; // clé de Zobrist des pavés déjà posés
+    int nombre;        // coins tirés, dans l'ordre du tirage
+    uint32_t *coins;   // coin haut gauche de chaque pavé, PAVES_POSSIBLES cases
+} pavage;
+
+struct partie;
+
+/** @typedef commandePavage
+ * @brief Procédure appelée quand les pavés d'un niveau sont posés, au début de la
+ *        partie puis à chaque passage : elle peut tirer d'avance le pavage du passage
+ *        suivant (preparation.h).
+ *
+ * @param atelier Pointeur donné dans les paramètres de la partie.
+ * @param jeu Partie dont les pavés viennent d'être posés.
+ */
+typedef void (*commandePavage)(void *atelier, const struct partie *jeu);
+
+/** @typedef livraisonPavage
+ * @brief Procédure appelée au passage de niveau : rend le dernier pavage tiré d'avance,
+ *        NULL s'il n'y en a pas. Il n'est pas modifié avant la commande suivante.
+ *
+ * @param atelier Pointeur donné dans les paramètres de la partie.
+ * @return Pavage tiré d'avance, utilisé seulement s'il correspond à la partie.
+ */
+typedef const pavage *(*livraisonPavage)(void *atelier);
+
+/** @typedef chronometrage
+ * @brief Temps passé dans chaque phase d'un déplacement, cumulé sur toutes les parties mesurées.
+ *
+ * La mesure lit l'horloge plusieurs fois par déplacement : elle ralentit la partie
+ * et n'est faite que si la partie en reçoit un.
+ */
+typedef struct
+{
+    long long deplacement; // nanosecondes : la queue recule et la tête avance
+    long long collision;   // nanosecondes : bordures, téléporteurs, serpent, pavés et pomme
+    long long pomme;       // nanosecondes : tirage de la pomme suivante
+    long long niveau;      // nanosecondes : pose des pavés du niveau suivant
+    long long niveauPrets; // nanosecondes : la même chose, pour les seuls pavages tirés d'avance
+    long nbDeplacements;
+    long nbPommes;
+    long nbNiveaux;
+    long nbPavagesPrets;   // passages de niveau dont le pavage était tiré d'avance
+} chronometrage;
+
+/** @typedef parametres
+ * @brief Réglages d'une nouvelle partie.
+ */
+typedef struct
+{
+    int largeur;           // coordonnée X de la bordure droite (creerPartie)
+    int hauteur;           // coordonnée Y de la bordure du bas (creerPartie)
+    int tailleMax;         // nombre maximum de segments du serpent (creerPartie)
+    int nombrePaves;       // nombre de pavés au départ
+    int tailleSerpent;     // taille que le serpent doit atteindre au départ
+    int niveau;            // nombre de pommes à manger pour le premier niveau
+    float vitesseSerpent;  // durée d'un déplacement au départ, en microsecondes
+    dessinateur dessiner;  // NULL pour une partie sans affichage
+    void *contexte;        // transmis à dessiner
+    chronometrage *chrono; // NULL pour ne pas mesurer les phases
+    commandePavage commander; // NULL pour tirer chaque pavage au passage de niveau
+    livraisonPavage livrer;
+    void *atelier;            // transmis à commander et livrer
+    const decor *decor;       // NULL pour le plateau par défaut, sinon aux dimensions de la partie
+} parametres;
+
+/** @typedef partie
+ * @brief État complet d'une partie.
+ *
+ * Toutes les procédures du jeu reçoivent la partie qu'elles modifient : plusieurs
+ * parties peuvent ainsi tourner côte à côte dans le même programme.
+ *
+ * Les dimensions sont fixées par creerPartie, qui alloue les tableaux. Le plateau
+ * est rangé ligne par ligne : la case (x, y) est plateau[NUMERO_CASE(jeu, x, y)] et
+ * les cases d'une même ligne se suivent en mémoire, comme à l'écran. Des cases de
+ * garde (x = 0 et largeur + 1, y = 0 et hauteur + 1) entourent les bordures et
+ * contiennent BORDURE : les quatre voisines d'une case du jeu, numéro + decalage(),
+ * existent toujours et se lisent sans tester les limites.
+ *
+ * Un nouveau champ d'état doit aussi être copié par copierEtat.
+ */
+typedef struct partie
+{
+    int largeur;                // coordonnée X de la bordure droite
+    int hauteur;                // coordonnée Y de la bordure du bas
+    int largeurLigne;           // largeur + 2 : cases d'une ligne, cases de garde comprises
+    uint32_t nbCases;           // largeurLigne * (hauteur + 2)
+    char *plateau;              // bordures, téléporteurs et pavés, nbCases cases
+    uint64_t *occupees;         // bit NUMERO_CASE à 1 pour un pavé ou le serpent, MOTS_DECOR mots
+    const decor *decor;         // plateau dessiné à l'avance, NULL pour le plateau par défaut
+    int nombrePortails;         // téléporteurs du plateau
+    portail portails[PORTAILS_MAX];
+    uint32_t *arrivees;         // ARRIVEE de la tête qui entre dans chaque case, téléporteurs faits, nbCases cases
+    uint32_t *destinations;     // numéro de la case d'arrivée, ou DESTINATION_MUR, rangé comme arrivees
+    int ecarts[4];              // écart entre une case et sa voisine, par INDICE_DIRECTION
+    serpent leSerpent;          // corps du serpent
+    casesLibres lesCasesLibres; // cases où la prochaine pomme peut apparaître
+    int pommeX;                 // position de la pomme courante
+    int pommeY;
+    int numeroPomme;            // nombre de pommes mangées
+    int nombrePaves;            // nombre de pavés posés
+    uint32_t *coinsPaves;       // coin haut gauche de chaque pavé posé, PAVES_POSSIBLES cases
+    uint64_t clePaves;          // clé de Zobrist des seuls pavés, obstacles du décor compris
+    int tailleSerpent;          // taille que le serpent doit atteindre
+    int level;                  // nombre de pommes à atteindre pour le prochain niveau
+    float vitesseSerpent;       // durée d'un déplacement en microsecondes
+    char direction;             // direction du dernier déplacement
+    uint64_t graine;            // graine de la partie, d'où sont aussi tirés les pavages des niveaux
+    generateur hasard;          // tirages des pavés et des pommes, propres à la partie
+    uint64_t cle;               // clé de Zobrist de l'état, tenue à jour à chaque déplacement
+    casesLibres ancrages;       // tampon de initPaves : coins où un pavé peut encore être posé
+    int *sommes;                // tampon de initAncrages : (largeurLigne + 1) * (hauteur + 3) sommes
+    pavage tirage;              // tampon de setLevel : pavage tiré au passage de niveau
+    dessinateur dessiner;       // procédure de dessin, NULL sans affichage
+    void *contexte;             // transmis à dessiner
+    chronometrage *chrono;      // temps par phase, NULL sans mesure
+    commandePavage commander;   // pavages tirés d'avance, NULL sans
+    livraisonPavage livrer;
+    void *atelier;
+} partie;
+
+/**
+ * @brief Remplit des paramètres avec les réglages du jeu d'origine, sans affichage.
+ *
+ * @param config Paramètres à remplir.
+ */
+void parametresParDefaut(parametres *config);
+
+/**
+ * @brief Alloue une partie aux dimensions des paramètres.
+ *
+ * Pour 4096 x 4096 cases, une partie occupe environ 440 Mo.
+ *
+ * @param jeu Partie à allouer.
+ * @param config Réglages (seuls largeur, hauteur et tailleMax servent ici), NULL pour les réglages par défaut.
+ * @return false si les dimensions sont hors limites ou si la mémoire manque (la partie est alors vide).
+ */
+bool creerPartie(partie *jeu, const parametres *config);
+
+/**
+ * @brief Libère la mémoire d'une partie. Sans effet sur une partie remplie de zéros.
+ *
+ * @param jeu Partie à libérer.
+ */
+void detruirePartie(partie *jeu);
+
+/**
+ * @brief Copie l'état du jeu d'une partie dans une autre de mêmes dimensions.
+ *
+ * La procédure de dessin, son contexte, le chronometrage et les tampons de la
+ * destination sont gardés.
+ *
+ * @param destination Partie qui reçoit l'état.
+ * @param source Partie copiée.
+ */
+void copierEtat(partie *destination, const partie *source);
+
+/**
+ * @brief Prépare une nouvelle partie : serpent, plateau, pavés et première pomme.
+ *
+ * La graine détermine les pavés et les pommes de la partie : deux parties de même
+ * graine et mêmes touches sont identiques, quel que soit le fil qui les joue. Un
+ * décor qui a sa propre graine la remplace : toutes ses parties ont les mêmes pommes.
+ *
+ * @param jeu Partie à initialiser, allouée par creerPartie.
+ * @param graine Graine du générateur de la partie.
+ * @param config Réglages de la partie, NULL pour les réglages par défaut ; les dimensions
+ *               restent celles données à creerPartie.
+ * @return false si la première pomme n'a pas pu être placée (plateau plein).
+ */
+bool initPartie(partie *jeu, uint64_t graine, const parametres *config);
+
+/**
+ * @brief Joue un déplacement : avance le serpent, mange la pomme et change de niveau si besoin.
+ *
+ * Une touche qui ferait demi-tour ou qui n'est pas une direction garde la direction
+ * du déplacement précédent.
+ *
+ * @param jeu Partie en cours.
+ * @param touche Direction demandée ('z', 's', 'q', 'd').
+ * @return Combinaison des EVENEMENT_* survenus pendant le déplacement.
+ */
+int avancer(partie *jeu, char touche);
+
+/**
+ * @brief Calcule entièrement la clé de Zobrist d'une partie.
+ *
+ * La clé est le ou exclusif d'une clé par pavé, par segment du serpent, pour la
+ * tête, pour la pomme, pour la direction et pour le nombre de pommes mangées.
+ * Les déplacements la tiennent à jour par quelques ou exclusifs : jeu->cle vaut
+ * toujours calculerCle(jeu), ce qui sert à vérifier la mise à jour.
+ *
+ * @param jeu Partie consultée.
+ * @return Clé de l'état de la partie.
+ */
+uint64_t calculerCle(const partie *jeu);
+
+/**
+ * @brief Alloue les coins d'un pavage aux dimensions d'une partie.
+ *
+ * @param tirage Pavage à allouer.
+ * @param modele Partie dont les dimensions sont reprises.
+ * @return false si la mémoire manque.
+ */
+bool creerPavage(pavage *tirage, const partie *modele);
+
+/**
+ * @brief Libère les coins d'un pavage. Sans effet sur un pavage rempli de zéros.
+ *
+ * @param tirage Pavage à libérer.
+ */
+void detruirePavage(pavage *tirage);
+
+/**
+ * @brief Initialise l'aire de jeu avec des bordures et de l'air.
+ *
+ * La clé de Zobrist n'est recalculée que par initPartie.
+ *
+ * @param jeu Partie dont le plateau est initialisé.
+ * @param nombrePaves Nombre de pavés à placer.
+ */
+void initPlateau(partie *jeu, int nombrePaves);
+
+/**
+ * @brief Remplit le plateau de bordures, de téléporteurs et d'air, puis des obstacles
+ *        du décor de la partie s'il y en a un, sans pavé tiré.
+ *
+ * Les téléporteurs de la partie sont ceux du décor, ou les quatre du plateau par
+ * défaut ; la table des arrivées est remplie en même temps. Ni le serpent, ni les
+ * cases libres, ni les clés ne sont touchés.
+ *
+ * @param jeu Partie dont le plateau est rempli.
+ */
+void initBordures(partie *jeu);
+
+/**
+ * @brief Tire les coins des pavés d'un passage de niveau, sans tenir compte du serpent.
+ *
+ * Les coins sont tirés comme par initPaves, avec un générateur propre au niveau
+ * (graine et level), parmi les coins que ne touchent ni les pavés de plan->plateau
+ * ni la zone de protection. Le plateau n'est pas modifié ; les tampons de plan servent.
+ *
+ * Tirés d'avance, les coins sont nouveaux + MARGE_PAVAGE(tailleSerpent) : assez pour
+ * que poserPavage remplace tous ceux que le serpent recouvrira. Tirés au passage de
+ * niveau sur la partie elle-même (libresSeulement), le tirage s'arrête dès que
+ * nouveaux coins sont libres du serpent. Les premiers coins sont les mêmes dans les
+ * deux cas, les pavés posés aussi.
+ *
+ * @param plan Partie dont le plateau porte les pavés déjà posés (plan->clePaves leur clé).
+ * @param graine Graine de la partie.
+ * @param level Valeur de jeu->level au passage de niveau.
+ * @param nouveaux Nombre de pavés à ajouter.
+ * @param tailleSerpent Taille que le serpent doit atteindre à ce niveau.
+ * @param libresSeulement true pour ne compter que les coins libres du serpent de plan.
+ * @param tirage Pavage qui reçoit les coins.
+ */
+void tirerPavage(partie *plan, uint64_t graine, int level, int nouveaux, int tailleSerpent, bool libresSeulement,
+                 pavage *tirage);
+
+/**
+ * @brief Pose les pavés d'un pavage jusqu'à en avoir nombrePaves.
+ *
+ * Les coins sont pris dans l'ordre du tirage ; un coin dont le pavé toucherait le
+ * serpent est sauté et remplacé par le suivant. Il ne manque des pavés que si le
+ * plateau n'avait plus de place pour tous les coins voulus : jeu->nombrePaves donne
+ * alors le nombre de pavés réellement posés.
+ *
+ * @param jeu Partie qui reçoit les pavés.
+ * @param tirage Pavage tiré pour cette partie, à ce niveau et avec ces pavés.
+ * @param nombrePaves Nombre total de pavés voulu après placement.
+ */
+void poserPavage(partie *jeu, const pavage *tirage, int nombrePaves);
+
+/**
+ * @brief Ajoute des pavés jusqu'à en avoir nombrePaves, en évitant la zone de protection et le serpent.
+ *
+ * Seules les cases des nouveaux pavés sont écrites dans le plateau et dessinées,
+ * les pavés déjà posés restent en place. Les pavés ne se chevauchent pas : chaque
+ * pavé est tiré parmi les coins encore valides, puis les coins qu'il recouvre sont
+ * retirés. Le placement se termine toujours, même quand il ne reste plus de place :
+ * jeu->nombrePaves donne alors le nombre de pavés réellement posés.
+ *
+ * @param jeu Partie dont le plateau reçoit les pavés.
+ * @param nombrePaves Nombre total de pavés voulu après placement.
+ */
+void initPaves(partie *jeu, int nombrePaves);
+
+/**
+ * @brief Remplit un ensemble avec tous les coins où un pavé peut être posé.
+ *
+ * Un coin est valide hors de la zone de protection si son rectangle ne touche ni
+ * pavé ni, si demandé, serpent ; le test utilise des sommes cumulées, en temps
+ * constant par coin.
+ *
+ * @param jeu Partie consultée.
+ * @param ancrages Ensemble des coins valides.
+ * @param avecSerpent false pour ignorer le serpent (tirage d'un pavage).
+ */
+void initAncrages(const partie *jeu, casesLibres *ancrages, bool avecSerpent);
+
+/**
+ * @brief Ajoute un numéro de case à un ensemble (sans effet s'il y est déjà).
+ *
+ * @param ensemble Ensemble de cases.
+ * @param numeroCase Numéro de la case.
+ */
+void ajouterCase(casesLibres *ensemble, uint32_t numeroCase);
+
+/**
+ * @brief Retire un numéro de case d'un ensemble (sans effet s'il n'y est pas).
+ *
+ * @param ensemble Ensemble de cases.
+ * @param numeroCase Numéro de la case.
+ */
+void retirerCase(casesLibres *ensemble, uint32_t numeroCase);
+
+/**
+ * @brief Numéro de la case rangée à un indice d'un ensemble.
+ *
+ * @param ensemble Ensemble de cases.
+ * @param indice Indice, inférieur à ensemble->nombre.
+ * @return Numéro de la case.
+ */
+uint32_t caseEnsemble(const casesLibres *ensemble, uint32_t indice);
+
+/**
+ * @brief Copie un ensemble de cases dans un autre, pour un plateau de même taille.
+ *
+ * Seuls les numéros sont lus dans la source, qui peut ne pas avoir de positions (cliché).
+ * Les positions de la destination, si elle en a, sont recalculées depuis les numéros
+ * dans les seuls blocs de 32 numéros qui changent : copier un ensemble proche
+ * de celui de la destination, comme en restaurant une recherche, ne touche que
+ * quelques blocs.
+ *
+ * @param destination Ensemble qui reçoit les cases.
+ * @param source Ensemble copié.
+ */
+void copierCases(casesLibres *destination, const casesLibres *source);
+
+/**
+ * @brief Place le serpent en ligne horizontale, tête en (x, y), et remplit sa grille d'occupation.
+ *
+ * @param jeu Partie dont le serpent est placé.
+ * @param x Coordonnée X de la tête.
+ * @param y Coordonnée Y de la tête.
+ */
+void initSerpent(partie *jeu, int x, int y);
+
+/**
+ * @brief Donne l'indice dans le tampon circulaire du i-ème segment du serpent.
+ *
+ * @param leSerpent Corps du serpent.
+ * @param i Numéro du segment (0 pour la tête).
+ * @return Indice du segment dans leSerpent->lesX et leSerpent->lesY.
+ */
+int indiceSegment(const serpent *leSerpent, int i);
+/**
+ * @brief  Place des pommes aléatoirement sur le plateau sans être sur le serpent si sur un pavés
+ *
+ * La pomme est tirée uniformément parmi les cases libres, en temps constant :
+ * le serpent et les pavés en sont déjà exclus.
+ *
+ * @param jeu Partie qui reçoit la pomme.
+ * @return false si aucune case n'est libre (plateau plein).
+ */
+bool ajouterPomme(partie *jeu);
+
+/**
+ * @brief Indique si une case fait partie de la zone où les pommes peuvent apparaître.
+ *
+ * @param jeu Partie consultée (pour ses dimensions).
+ * @param x Coordonnée X.
+ * @param y Coordonnée Y.
+ * @return true si une pomme peut être posée sur cette case quand elle est libre.
+ */
+bool zonePomme(const partie *jeu, int x, int y);
+
+/**
+ * @brief Remplit l'ensemble des cases libres à partir du plateau et du serpent.
+ *
+ * @param jeu Partie consultée.
+ */
+void initCasesLibres(partie *jeu);
+
+/**
+ * @brief Ajoute une case à l'ensemble des cases libres (sans effet si elle y est déjà ou hors zone).
+ *
+ * @param jeu Partie concernée.
+ * @param x Coordonnée X.
+ * @param y Coordonnée Y.
+ */
+void libererCase(partie *jeu, int x, int y);
+
+/**
+ * @brief Retire une case de l'ensemble des cases libres (sans effet si elle n'y est pas).
+ *
+ * @param jeu Partie concernée.
+ * @param x Coordonnée X.
+ * @param y Coordonnée Y.
+ */
+void occuperCase(partie *jeu, int x, int y);
+
+/**
+ * @brief Passe au niveau suivant si besoin puis place la pomme suivante.
+ *
+ * Les nouveaux pavés viennent du pavage livré par la partie s'il a été tiré pour
+ * ce niveau et ces pavés, sinon d'un pavage tiré sur place : le résultat est le même.
+ *
+ * @param jeu Partie dont une pomme vient d'être mangée.
+ * @return false si la pomme n'a pas pu être placée (plateau plein).
+ */
+bool setLevel(partie *jeu);
+
+bool teteTouchePomme(const partie *jeu);
+
+/**
+ * @brief Initialise un générateur à partir d'une graine (splitmix64).
+ *
+ * Des graines voisines, comme graine + i pour la partie i, donnent des suites sans rapport.
+ *
+ * @param hasard Générateur à initialiser.
+ * @param graine Graine.
+ */
+void initGenerateur(generateur hasard, uint64_t graine);
+
+/**
+ * @brief Tire l'entier suivant du générateur (xoshiro256**).
+ *
+ * @param hasard Générateur.
+ * @return Entier sur 64 bits.
+ */
+uint64_t tirerGenerateur(generateur hasard);
+
+/**
+ * @brief Tire un entier entre 0 et borne - 1.
+ *
+ * @param hasard Générateur.
+ * @param borne Nombre de valeurs possibles (strictement positif).
+ * @return Entier tiré.
+ */
+int tirerEntier(generateur hasard, int borne);
+/**
+ * @brief Détermine la nouvelle direction du serpent en fonction de la touche appuyée.
+ *
+ * @param touche Touche saisie par l'utilisateur.
+ * @param direction Direction actuelle.
+ * @return Nouvelle direction.
+ */
+char definirDirection(char touche, char direction);
+
+/**
+ * @brief Calcule la case où arrive la tête, téléporteurs compris.
+ *
+ * Ne dépend que des dimensions, des téléporteurs, de la position de la tête et de la
+ * direction : le calcul peut être fait pour plusieurs parties à la fois avant
+ * d'appliquer les déplacements. La case voisine est lue dans la table des arrivées,
+ * remplie au chargement du plateau : ni comparaison de coordonnées, ni recherche
+ * de téléporteur.
+ *
+ * @param jeu Partie consultée (pour ses dimensions et sa table des arrivées).
+ * @param x Coordonnée X de la tête.
+ * @param y Coordonnée Y de la tête.
+ * @param direction Direction du mouvement, une des quatre touches 'z', 's', 'q', 'd'.
+ * @param nouveauX Coordonnée X de la nouvelle tête.
+ * @param nouveauY Coordonnée Y de la nouvelle tête.
+ * @return true si la tête heurte une bordure hors téléporteur.
+ */
+bool prochaineTete(const partie *jeu, int x, int y, char direction, int *nouveauX, int *nouveauY);
+
+/**
+ * @brief Écart entre le numéro d'une case et celui de sa voisine dans une direction.
+ *
+ * @param jeu Partie consultée (pour la longueur de ses lignes).
+ * @param direction Direction ('z', 's', 'q', 'd').
+ * @return 1 ou -1 pour une voisine de la même ligne, largeurLigne ou -largeurLigne sinon.
+ */
+int decalage(const partie *jeu, char direction);
+
+/**
+ * @brief Applique un déplacement dont la nouvelle tête est déjà calculée, puis ses conséquences.
+ *
+ * Mange la pomme, change de niveau et place la pomme suivante si besoin.
+ *
+ * @param jeu Partie en cours.
+ * @param direction Direction du mouvement, déjà validée par definirDirection.
+ * @param x Coordonnée X de la nouvelle tête (donnée par prochaineTete).
+ * @param y Coordonnée Y de la nouvelle tête.
+ * @param bordure true si prochaineTete a signalé une bordure.
+ * @return Combinaison des EVENEMENT_* survenus pendant le déplacement.
+ */
+int appliquerDeplacement(partie *jeu, char direction, int x, int y, bool bordure);
+
+/**
+ * @brief Déplace le serpent jusqu'à une nouvelle tête déjà calculée et détecte les collisions.
+ *
+ * Le déplacement coûte le même temps quelle que soit la taille du serpent :
+ * une nouvelle tête est écrite et la queue recule, sauf si le serpent grandit.
+ *
+ * @param jeu Partie en cours.
+ * @param direction Direction du mouvement, pour le dessin de la tête.
+ * @param x Coordonnée X de la nouvelle tête.
+ * @param y Coordonnée Y de la nouvelle tête.
+ * @param statut Mis à true si une collision avec le serpent ou un pavé a été détectée.
+ * @param pomme Indique si la pomme vient d'être mangée.
+ */
+void deplacerSerpent(partie *jeu, char direction, int x, int y, bool *statut, bool *pomme);
+
+/**
+ * @brief Déplace le serpent d'une case dans la direction donnée.
+ *
+ * Enchaîne prochaineTete et deplacerSerpent, sans manger la pomme ni changer de niveau.
+ *
+ * @param jeu Partie en cours.
+ * @param direction Direction du mouvement ('z', 's', 'q', 'd').
+ * @param statut Indique si une collision a été détectée.
+ * @param pomme Indique si la pomme vient d'être mangée.
+ */
+void progresser(partie *jeu, char direction, bool *statut, bool *pomme);
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ * @file lot.c
+ * @brief Lot de parties du jeu Snake (version 4) avancées ensemble.
+ *
+ * Un déplacement du lot se fait en deux temps : calculerTetes calcule toutes les
+ * directions et cases voisines dans une boucle vectorisée et lit chaque nouvelle
+ * tête dans la table des arrivées de sa partie, puis chaque partie en cours applique
+ * son déplacement avec appliquerDeplacement, comme avancer le ferait.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "lot.h"
+
+/** @brief GCC ne vectorise la boucle de tetesSuivantes qu'en -O3 : la vectorisation lui est demandée pour elle seule */
+#if defined(__GNUC__) && !defined(__clang__)
+#define VECTORISER __attribute__((optimize("tree-vectorize")))
+#else
+#define VECTORISER
+#endif
+
+/**
+ * @brief Boucle de calculerTetes sur des tableaux qui ne se recouvrent pas (restrict),
+ *        condition pour que le compilateur la vectorise.
+ */
+VECTORISER static void tetesSuivantes(int nombre, int largeurLigne, const int ecarts[4], const char *restrict touches,
+                           const int *restrict teteX, const int *restrict teteY, int *restrict direction,
+                           int *restrict voisine);
+
+/*****************************************************
+ *                 PROCEDURE                         *
+ *****************************************************/
+bool creerLot(lot *leLot, int nombre, const parametres *config)
+{
+    parametres parDefaut;
+    bool cree;
+
+    if (config == NULL)
+    {
+        parametresParDefaut(&parDefaut);
+        config = &parDefaut;
+    }
+    leLot->nombre = nombre;
+    leLot->capacite = nombre;
+    leLot->largeur = config->largeur;
+    leLot->hauteur = config->hauteur;
+    leLot->teteX = malloc(nombre * sizeof(int));
+    leLot->teteY = malloc(nombre * sizeof(int));
+    leLot->direction = malloc(nombre * sizeof(int));
+    leLot->enCours = malloc(nombre * sizeof(int));
+    leLot->voisine = malloc(nombre * sizeof(int));
+    leLot->arrivees = malloc(nombre * sizeof(uint32_t *));
+    leLot->suivantX = malloc(nombre * sizeof(int));
+    leLot->suivantY = malloc(nombre * sizeof(int));
+    leLot->bordure = malloc(nombre * sizeof(int));
+    leLot->parties = calloc(nombre, sizeof(partie));
+
+    cree = (leLot->teteX != NULL) && (leLot->teteY != NULL) && (leLot->direction != NULL)
+        && (leLot->enCours != NULL) && (leLot->voisine != NULL) && (leLot->arrivees != NULL)
+        && (leLot->suivantX != NULL) && (leLot->suivantY != NULL)
+        && (leLot->bordure != NULL) && (leLot->parties != NULL);
+    for (int i = 0; cree && (i < nombre); i++)
+    {
+        cree = creerPartie(&leLot->parties[i], config);
+        if (cree)
+        {
+            leLot->arrivees[i] = leLot->parties[i].arrivees;
+        }
+    }
+    if (cree)
+    {
+        leLot->largeurLigne = leLot->parties[0].largeurLigne;
+        memcpy(leLot->ecarts, leLot->parties[0].ecarts, sizeof(leLot->ecarts));
+    }
+    if (!cree)
+    {
+        detruireLot(leLot);
+    }
+    return cree;
+}
+
+void detruireLot(lot *leLot)
+{
+    free(leLot->teteX);
+    free(leLot->teteY);
+    free(leLot->direction);
+    free(leLot->enCours);
+    free(leLot->voisine);
+    free(leLot->arrivees);
+    free(leLot->suivantX);
+    free(leLot->suivantY);
+    free(leLot->bordure);
+    if (leLot->parties != NULL)
+    {
+        // une partie jamais créée est à zéro : detruirePartie n'a rien à libérer
+        for (int i = 0; i < leLot->capacite; i++)
+        {
+            detruirePartie(&leLot->parties[i]);
+        }
+    }
+    free(leLot->parties);
+    memset(leLot, 0, sizeof(*leLot));
+}
+
+void initLot(lot *leLot, uint64_t graine, const parametres *config)
+{
+    const serpent *leSerpent;
+
+    for (int i = 0; i < leLot->nombre; i++)
+    {
+        leLot->enCours[i] = initPartie(&leLot->parties[i], graine + i, config);
+        leSerpent = &leLot->parties[i].leSerpent;
+        leLot->teteX[i] = leSerpent->lesX[leSerpent->tete];
+        leLot->teteY[i] = leSerpent->lesY[leSerpent->tete];
+        leLot->direction[i] = leLot->parties[i].direction;
+    }
+}
+
+void calculerTetes(lot *leLot, const char touches[])
+{
+    uint32_t arrivee;
+
+    tetesSuivantes(leLot->nombre, leLot->largeurLigne, leLot->ecarts, touches, leLot->teteX, leLot->teteY,
+                   leLot->direction, leLot->voisine);
+
+    // prochaineTete : une lecture par partie en cours, dans sa propre table
+    for (int i = 0; i < leLot->nombre; i++)
+    {
+        if (leLot->enCours[i])
+        {
+            arrivee = leLot->arrivees[i][leLot->voisine[i]];
+            leLot->suivantX[i] = ARRIVEE_X(arrivee);
+            leLot->suivantY[i] = ARRIVEE_Y(arrivee);
+            leLot->bordure[i] = (arrivee & ARRIVEE_MUR) != 0;
+        }
+    }
+}
+
+int avancerLot(lot *leLot, const char touches[], int evenements[])
+{
+    const serpent *leSerpent;
+    int enCours = 0;
+
+    calculerTetes(leLot, touches);
+
+    // Application dans l'ordre des parties : chaque partie garde son propre état
+    for (int i = 0; i < leLot->nombre; i++)
+    {
+        evenements[i] = 0;
+        if (leLot->enCours[i])
+        {
+            evenements[i] = appliquerDeplacement(&leLot->parties[i], (char)leLot->direction[i],
+                                                 leLot->suivantX[i], leLot->suivantY[i], leLot->bordure[i]);
+            leSerpent = &leLot->parties[i].leSerpent;
+            leLot->teteX[i] = leSerpent->lesX[leSerpent->tete];
+            leLot->teteY[i] = leSerpent->lesY[leSerpent->tete];
+            leLot->enCours[i] = (evenements[i] & EVENEMENT_FIN) == 0;
+            enCours += leLot->enCours[i];
+        }
+        else
+        {
+            // une partie terminée garde sa direction
+            leLot->direction[i] = leLot->parties[i].direction;
+        }
+    }
+    return enCours;
+}
+
+/*****************************************************
+ *                 BOITES A OUTILS                   *
+ *****************************************************/
+VECTORISER static void tetesSuivantes(int nombre, int largeurLigne, const int ecarts[4], const char *restrict touches,
+                           const int *restrict teteX, const int *restrict teteY, int *restrict direction,
+                           int *restrict voisine)
+{
+    int touche, ancienne, nouvelle, indice;
+    int versHaut, versBas, versGauche, versDroite, demiTour;
+
+    for (int i = 0; i < nombre; i++)
+    {
+        // definirDirection : une touche valide qui ne fait pas demi-tour remplace la direction
+        touche = touches[i];
+        ancienne = direction[i];
+        versHaut = touche == HAUT;
+        versBas = touche == BAS;
+        versGauche = touche == GAUCHE;
+        versDroite = touche == DROITE;
+        demiTour = (versHaut & (ancienne == BAS)) | (versBas & (ancienne == HAUT))
+                 | (versGauche & (ancienne == DROITE)) | (versDroite & (ancienne == GAUCHE));
+        nouvelle = ((versHaut + versBas + versGauche + versDroite) & !demiTour) ? touche : ancienne;
+        direction[i] = nouvelle;
+
+        // case voisine par partie->ecarts, l'écart choisi sans lecture indexée
+        indice = INDICE_DIRECTION(nouvelle);
+        voisine[i] = teteY[i] * largeurLigne + teteX[i]
+                   + (indice == 0) * ecarts[0] + (indice == 1) * ecarts[1]
+                   + (indice == 2) * ecarts[2] + (indice == 3) * ecarts[3];
+    }
+}
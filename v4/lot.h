@@ -0,0 +1,100 @@
+/**
+ * @file lot.h
+ * @brief Lot de parties du jeu Snake (version 4) avancées ensemble, d'un déplacement à la fois.
+ *
+ * Seules les données du calcul des nouvelles têtes sont rangées en tableaux séparés,
+ * une case par partie : position de la tête, direction, partie en cours, case voisine,
+ * nouvelle tête et bordure heurtée, plus un pointeur vers la table des arrivées de
+ * chaque partie. Direction et case voisine sont calculées par une boucle sans appel
+ * ni branche, vectorisée (lot.c la demande à GCC, qui ne la vectorise sinon qu'en
+ * -O3). La taille du serpent, son corps, l'occupation des cases et le plateau restent
+ * dans la structure partie de chaque partie : ils sont lus à des cases différentes
+ * d'une partie à l'autre, un tableau par champ n'y gagnerait rien.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#ifndef LOT_H
+#define LOT_H
+
+#include "libsnake.h"
+
+/** @typedef lot
+ * @brief Parties avancées ensemble.
+ */
+typedef struct
+{
+    int nombre;       // nombre de parties du lot
+    int capacite;     // nombre de parties allouées par creerLot, au moins nombre
+    int largeur;      // dimensions du plateau, communes à toutes les parties
+    int hauteur;
+    int largeurLigne; // cases d'une ligne du plateau, et écart entre une case et sa voisine
+    int ecarts[4];    // par INDICE_DIRECTION, communs à toutes les parties
+    int *teteX;       // position de la tête de chaque partie
+    int *teteY;
+    int *direction;   // direction du dernier déplacement
+    int *enCours;     // 1 tant que la partie n'est pas terminée
+    int *voisine;     // case voisine de la tête dans la nouvelle direction
+    const uint32_t **arrivees; // table des arrivées de chaque partie
+    int *suivantX;    // nouvelle tête calculée par calculerTetes
+    int *suivantY;
+    int *bordure;     // 1 si la nouvelle tête heurte une bordure hors téléporteur
+    partie *parties;  // reste de l'état de chaque partie
+} lot;
+
+/**
+ * @brief Alloue un lot de parties, toutes aux dimensions de config.
+ *
+ * @param leLot Lot à allouer.
+ * @param nombre Nombre de parties.
+ * @param config Réglages des parties, NULL pour les réglages par défaut.
+ * @return false si la mémoire manque ou si les dimensions sont invalides (le lot est alors vide).
+ */
+bool creerLot(lot *leLot, int nombre, const parametres *config);
+
+/**
+ * @brief Libère la mémoire d'un lot.
+ *
+ * @param leLot Lot à libérer.
+ */
+void detruireLot(lot *leLot);
+
+/**
+ * @brief Commence une nouvelle partie dans chaque case du lot.
+ *
+ * La partie i est initialisée avec la graine graine + i, dans l'ordre des parties.
+ *
+ * @param leLot Lot de parties.
+ * @param graine Graine de la première partie.
+ * @param config Réglages des parties, NULL pour les réglages par défaut ;
+ *               mêmes dimensions que celles données à creerLot.
+ */
+void initLot(lot *leLot, uint64_t graine, const parametres *config);
+
+/**
+ * @brief Calcule la nouvelle tête de chaque partie, sans rien modifier d'autre.
+ *
+ * La direction et la case voisine de la tête suivent les règles de definirDirection,
+ * écrites sans branche pour être vectorisées (SSE2 sur x86-64, AVX2 avec -march=native, NEON sur ARM).
+ * La nouvelle tête est ensuite lue, comme prochaineTete, dans la table des arrivées
+ * de chaque partie en cours : téléporteurs par défaut ou d'un décor (niveaux.h) et
+ * bordures n'ont qu'une source, la table.
+ *
+ * @param leLot Lot de parties.
+ * @param touches Touche jouée par chaque partie.
+ */
+void calculerTetes(lot *leLot, const char touches[]);
+
+/**
+ * @brief Avance d'un déplacement toutes les parties en cours du lot.
+ *
+ * @param leLot Lot de parties.
+ * @param touches Touche jouée par chaque partie.
+ * @param evenements Combinaison des EVENEMENT_* de chaque partie (0 pour une partie déjà terminée).
+ * @return Nombre de parties encore en cours.
+ */
+int avancerLot(lot *leLot, const char touches[], int evenements[]);
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * @file niveaux.c
+ * @brief Recueil de niveaux : en-tête, ouverture par projection en mémoire et accès aux décors.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "niveaux.h"
+
+/*****************************************************
+ *                 PROCEDURE                         *
+ *****************************************************/
+size_t tailleDecor(int largeur, int hauteur)
+{
+    return sizeof(decor) + MOTS_DECOR(largeur, hauteur) * sizeof(uint64_t);
+}
+
+void remplirEntete(enteteRecueil *entete, int largeur, int hauteur, int nombre)
+{
+    memset(entete, 0, sizeof(*entete));
+    memcpy(entete->magie, MAGIE_RECUEIL, sizeof(entete->magie));
+    entete->version = VERSION_RECUEIL;
+    entete->largeur = (uint32_t)largeur;
+    entete->hauteur = (uint32_t)hauteur;
+    entete->nombre = (uint32_t)nombre;
+    entete->tailleNiveau = tailleDecor(largeur, hauteur);
+}
+
+bool ouvrirRecueil(recueil *leRecueil, const char *chemin)
+{
+    const enteteRecueil *entete;
+    struct stat etat;
+    int fichier = open(chemin, O_RDONLY);
+    bool ouvert = (fichier >= 0) && (fstat(fichier, &etat) == 0) && ((size_t)etat.st_size >= sizeof(enteteRecueil));
+
+    memset(leRecueil, 0, sizeof(*leRecueil));
+    if (ouvert)
+    {
+        leRecueil->taille = (size_t)etat.st_size;
+        leRecueil->carte = mmap(NULL, leRecueil->taille, PROT_READ, MAP_PRIVATE, fichier, 0);
+        ouvert = leRecueil->carte != MAP_FAILED;
+    }
+    if (fichier >= 0)
+    {
+        // la projection reste valide sans le descripteur
+        close(fichier);
+    }
+    if (ouvert)
+    {
+        entete = leRecueil->carte;
+        ouvert = (memcmp(entete->magie, MAGIE_RECUEIL, sizeof(entete->magie)) == 0)
+              && (entete->version == VERSION_RECUEIL)
+              && (entete->largeur >= LARGEUR_PLUS_PETITE) && (entete->largeur <= DIMENSION_MAX)
+              && (entete->hauteur >= HAUTEUR_PLUS_PETITE) && (entete->hauteur <= DIMENSION_MAX)
+              && (entete->tailleNiveau == tailleDecor((int)entete->largeur, (int)entete->hauteur))
+              && (entete->nombre <= (leRecueil->taille - sizeof(enteteRecueil)) / entete->tailleNiveau)
+              && (entete->nombre <= INT32_MAX);
+        if (ouvert)
+        {
+            leRecueil->largeur = (int)entete->largeur;
+            leRecueil->hauteur = (int)entete->hauteur;
+            leRecueil->nombre = (int)entete->nombre;
+            leRecueil->tailleNiveau = entete->tailleNiveau;
+            leRecueil->niveaux = (const unsigned char *)leRecueil->carte + sizeof(enteteRecueil);
+        }
+        else
+        {
+            munmap(leRecueil->carte, leRecueil->taille);
+        }
+    }
+    if (!ouvert)
+    {
+        memset(leRecueil, 0, sizeof(*leRecueil));
+    }
+    return ouvert;
+}
+
+void fermerRecueil(recueil *leRecueil)
+{
+    if (leRecueil->carte != NULL)
+    {
+        munmap(leRecueil->carte, leRecueil->taille);
+    }
+    memset(leRecueil, 0, sizeof(*leRecueil));
+}
+
+const decor *decorRecueil(const recueil *leRecueil, int numero)
+{
+    // l'en-tête et chaque niveau font un multiple de 8 octets : le décor est aligné
+    return (const decor *)(leRecueil->niveaux + (size_t)numero * leRecueil->tailleNiveau);
+}
@@ -0,0 +1,105 @@
+/**
+ * @file niveaux.h
+ * @brief Recueil de niveaux dessinés à l'avance, lu en projetant le fichier en mémoire.
+ *
+ * Un recueil est un en-tête suivi de niveaux de même taille, tous aux mêmes
+ * dimensions. Chaque niveau est un decor (libsnake.h) rangé tel qu'en mémoire :
+ * ouvrirRecueil ne lit que l'en-tête, le niveau i est à une adresse calculée et
+ * ses pages ne sont lues qu'au moment où une partie le joue. Le fichier est écrit
+ * dans l'ordre des octets de la machine ; un recueil venu d'une machine d'un autre
+ * ordre est refusé (sa version ne correspond pas).
+ *
+ * Les recueils sont écrits par le convertisseur (convertir.c), à partir de cartes en
+ * texte qui utilisent les caractères BORDURE, PAVES et AIR du jeu.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#ifndef NIVEAUX_H
+#define NIVEAUX_H
+
+#include <stddef.h>
+#include "libsnake.h"
+
+/** @brief Huit premiers octets d'un recueil */
+#define MAGIE_RECUEIL "SNAKENIV"
+/** @brief Version du format, changée à chaque modification de decor ou de l'en-tête */
+#define VERSION_RECUEIL 1
+
+/** @typedef enteteRecueil
+ * @brief Début du fichier d'un recueil, suivi de nombre niveaux de tailleNiveau octets.
+ */
+typedef struct
+{
+    char magie[8];          // MAGIE_RECUEIL, sans zéro final
+    uint32_t version;       // VERSION_RECUEIL
+    uint32_t largeur;       // dimensions de tous les niveaux
+    uint32_t hauteur;
+    uint32_t nombre;        // nombre de niveaux
+    uint64_t tailleNiveau;  // tailleDecor(largeur, hauteur)
+} enteteRecueil;
+
+/** @typedef recueil
+ * @brief Recueil ouvert : fichier projeté en mémoire, en lecture seule.
+ */
+typedef struct
+{
+    void *carte;                  // début de la projection
+    size_t taille;                // taille de la projection
+    int largeur;                  // dimensions des niveaux, à donner à creerPartie
+    int hauteur;
+    int nombre;                   // nombre de niveaux
+    size_t tailleNiveau;          // octets d'un niveau
+    const unsigned char *niveaux; // premier niveau, juste après l'en-tête
+} recueil;
+
+/**
+ * @brief Taille d'un décor aux dimensions données, masque des obstacles compris.
+ *
+ * @param largeur Largeur du plateau.
+ * @param hauteur Hauteur du plateau.
+ * @return Nombre d'octets, multiple de 8.
+ */
+size_t tailleDecor(int largeur, int hauteur);
+
+/**
+ * @brief Remplit l'en-tête d'un recueil.
+ *
+ * @param entete En-tête à remplir.
+ * @param largeur Largeur des niveaux.
+ * @param hauteur Hauteur des niveaux.
+ * @param nombre Nombre de niveaux.
+ */
+void remplirEntete(enteteRecueil *entete, int largeur, int hauteur, int nombre);
+
+/**
+ * @brief Ouvre un recueil en projetant son fichier en mémoire.
+ *
+ * Seuls l'en-tête et la taille du fichier sont vérifiés : le temps d'ouverture ne
+ * dépend pas du nombre de niveaux.
+ *
+ * @param leRecueil Recueil à ouvrir.
+ * @param chemin Chemin du fichier.
+ * @return false si le fichier ne peut pas être ouvert ou n'est pas un recueil (le recueil est alors vide).
+ */
+bool ouvrirRecueil(recueil *leRecueil, const char *chemin);
+
+/**
+ * @brief Ferme un recueil. Les décors qu'il a donnés ne doivent plus servir.
+ *
+ * @param leRecueil Recueil à fermer.
+ */
+void fermerRecueil(recueil *leRecueil);
+
+/**
+ * @brief Donne un niveau d'un recueil, à placer dans parametres.decor.
+ *
+ * @param leRecueil Recueil ouvert.
+ * @param numero Numéro du niveau, de 0 à nombre - 1.
+ * @return Décor du niveau, dans la projection du fichier.
+ */
+const decor *decorRecueil(const recueil *leRecueil, int numero);
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * @file ouvriers.c
+ * @brief Répartition de tâches entre fils d'exécution, avec vol de travail.
+ *
+ * Les tâches restantes d'un fil forment un intervalle [debut, fin[ rangé dans un seul
+ * entier de 64 bits (debut dans les 32 bits hauts). Le fil prend ses tâches par le
+ * début, les voleurs prennent par la fin ; les deux modifient l'intervalle par
+ * compare-and-swap, sans verrou.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "ouvriers.h"
+
+/** @brief Taille d'une ligne de cache, pour que deux fils ne partagent pas la même */
+#define LIGNE_CACHE 64
+
+/** @typedef ouvrier
+ * @brief État d'un fil d'exécution.
+ */
+typedef struct
+{
+    _Alignas(LIGNE_CACHE) _Atomic uint64_t intervalle; // tâches restantes : debut << 32 | fin
+    int numero;
+    int nbFils;
+    void *tous;         // tableau de tous les ouvriers
+    tache travail;
+    void *donnees;
+    bilanFil bilan;
+    pthread_t identifiant;
+} ouvrier;
+
+/**
+ * @brief Boucle d'un fil : ses propres tâches, puis celles qu'il vole, jusqu'à ce qu'il n'en reste plus.
+ *
+ * @param argument Ouvrier du fil.
+ * @return NULL.
+ */
+static void *travailler(void *argument);
+
+/**
+ * @brief Prend la première tâche de l'intervalle d'un ouvrier.
+ *
+ * @param lui Ouvrier.
+ * @param indice Tâche prise.
+ * @return false si l'intervalle est vide.
+ */
+static bool prendre(ouvrier *lui, int *indice);
+
+/**
+ * @brief Prend la moitié des tâches restantes de l'ouvrier le plus chargé.
+ *
+ * La première tâche volée est rendue dans indice, les autres deviennent l'intervalle du voleur.
+ *
+ * @param voleur Ouvrier dont l'intervalle est vide.
+ * @param indice Première tâche volée.
+ * @return false s'il ne reste de tâche chez personne.
+ */
+static bool voler(ouvrier *voleur, int *indice);
+
+/**
+ * @brief Range un intervalle [debut, fin[ dans un entier de 64 bits.
+ */
+static uint64_t emballer(uint32_t debut, uint32_t fin);
+
+/*****************************************************
+ *                 PROCEDURE                         *
+ *****************************************************/
+bool repartirTaches(int nbTaches, int nbFils, tache travail, void *donnees, bilanFil bilans[])
+{
+    ouvrier lesOuvriers[NB_FILS_MAX];
+    int crees = 0;
+    bool possible = (nbFils >= 1) && (nbFils <= NB_FILS_MAX) && (nbTaches >= 0);
+
+    for (int k = 0; possible && (k < nbFils); k++)
+    {
+        // tranches contiguës de même taille à une tâche près
+        atomic_init(&lesOuvriers[k].intervalle,
+                    emballer((uint32_t)((long long)nbTaches * k / nbFils),
+                             (uint32_t)((long long)nbTaches * (k + 1) / nbFils)));
+        lesOuvriers[k].numero = k;
+        lesOuvriers[k].nbFils = nbFils;
+        lesOuvriers[k].tous = lesOuvriers;
+        lesOuvriers[k].travail = travail;
+        lesOuvriers[k].donnees = donnees;
+        lesOuvriers[k].bilan.taches = 0;
+        lesOuvriers[k].bilan.vols = 0;
+    }
+    while (possible && (crees < nbFils))
+    {
+        possible = pthread_create(&lesOuvriers[crees].identifiant, NULL, travailler, &lesOuvriers[crees]) == 0;
+        if (possible)
+        {
+            crees++;
+        }
+    }
+    // un fil non créé ne fait rien : les autres lui volent toute sa tranche
+    for (int k = 0; k < crees; k++)
+    {
+        pthread_join(lesOuvriers[k].identifiant, NULL);
+    }
+    if (possible && (bilans != NULL))
+    {
+        for (int k = 0; k < nbFils; k++)
+        {
+            bilans[k] = lesOuvriers[k].bilan;
+        }
+    }
+    return possible;
+}
+
+static void *travailler(void *argument)
+{
+    ouvrier *lui = argument;
+    int indice;
+
+    while (prendre(lui, &indice) || voler(lui, &indice))
+    {
+        lui->travail(indice, lui->numero, lui->donnees);
+        lui->bilan.taches++;
+    }
+    return NULL;
+}
+
+static bool prendre(ouvrier *lui, int *indice)
+{
+    uint64_t ancien = atomic_load(&lui->intervalle);
+    uint32_t debut, fin;
+    bool pris = false;
+    bool fini = false;
+
+    while (!fini)
+    {
+        debut = (uint32_t)(ancien >> 32);
+        fin = (uint32_t)ancien;
+        if (debut >= fin)
+        {
+            fini = true;
+        }
+        else if (atomic_compare_exchange_weak(&lui->intervalle, &ancien, emballer(debut + 1, fin)))
+        {
+            // en cas d'échec, ancien contient la nouvelle valeur et on recommence
+            *indice = (int)debut;
+            pris = true;
+            fini = true;
+        }
+    }
+    return pris;
+}
+
+static bool voler(ouvrier *voleur, int *indice)
+{
+    ouvrier *tous = voleur->tous;
+    ouvrier *victime;
+    uint64_t ancien;
+    uint32_t debut, fin, restant, plusGrand, moitie;
+    bool vole = false;
+    bool personne = false;
+
+    while (!vole && !personne)
+    {
+        // l'ouvrier qui a le plus de tâches restantes
+        victime = NULL;
+        plusGrand = 0;
+        for (int k = 1; k < voleur->nbFils; k++)
+        {
+            ouvrier *autre = &tous[(voleur->numero + k) % voleur->nbFils];
+            ancien = atomic_load(&autre->intervalle);
+            debut = (uint32_t)(ancien >> 32);
+            fin = (uint32_t)ancien;
+            restant = (debut < fin) ? fin - debut : 0;
+            if (restant > plusGrand)
+            {
+                plusGrand = restant;
+                victime = autre;
+            }
+        }
+
+        if (victime == NULL)
+        {
+            personne = true;
+        }
+        else
+        {
+            ancien = atomic_load(&victime->intervalle);
+            debut = (uint32_t)(ancien >> 32);
+            fin = (uint32_t)ancien;
+            if (debut < fin)
+            {
+                moitie = (fin - debut + 1) / 2;
+                if (atomic_compare_exchange_strong(&victime->intervalle, &ancien, emballer(debut, fin - moitie)))
+                {
+                    // les tâches [fin - moitie, fin[ appartiennent maintenant au voleur
+                    *indice = (int)(fin - moitie);
+                    atomic_store(&voleur->intervalle, emballer(fin - moitie + 1, fin));
+                    voleur->bilan.vols++;
+                    vole = true;
+                }
+            }
+        }
+    }
+    return vole;
+}
+
+/*****************************************************
+ *                 BOITES A OUTILS                   *
+ *****************************************************/
+static uint64_t emballer(uint32_t debut, uint32_t fin)
+{
+    return ((uint64_t)debut << 32) | fin;
+}
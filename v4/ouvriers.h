@@ -0,0 +1,54 @@
+/**
+ * @file ouvriers.h
+ * @brief Répartition de tâches indépendantes entre plusieurs fils d'exécution, avec vol de travail.
+ *
+ * Chaque fil reçoit au départ une tranche contiguë des tâches. Un fil qui a fini sa
+ * tranche prend la moitié de ce qui reste au fil le plus chargé : les longues parties
+ * ne laissent pas de cœur inoccupé.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#ifndef OUVRIERS_H
+#define OUVRIERS_H
+
+#include <stdbool.h>
+
+/** @brief Nombre maximum de fils d'exécution */
+#define NB_FILS_MAX 256
+
+/** @typedef tache
+ * @brief Travail à faire pour une tâche.
+ *
+ * @param indice Numéro de la tâche, de 0 à nbTaches - 1.
+ * @param fil Numéro du fil qui l'exécute, de 0 à nbFils - 1.
+ * @param donnees Pointeur donné à repartirTaches.
+ */
+typedef void (*tache)(int indice, int fil, void *donnees);
+
+/** @typedef bilanFil
+ * @brief Ce qu'un fil a fait pendant repartirTaches.
+ */
+typedef struct
+{
+    int taches; // nombre de tâches exécutées
+    int vols;   // nombre de fois où il a pris du travail à un autre fil
+} bilanFil;
+
+/**
+ * @brief Exécute les tâches 0 à nbTaches - 1 sur nbFils fils, chacune une seule fois.
+ *
+ * Revient quand toutes les tâches sont terminées.
+ *
+ * @param nbTaches Nombre de tâches.
+ * @param nbFils Nombre de fils (de 1 à NB_FILS_MAX).
+ * @param travail Procédure exécutée pour chaque tâche.
+ * @param donnees Transmis à travail.
+ * @param bilans Bilan de chaque fil, NULL si inutile.
+ * @return false si les fils n'ont pas pu être créés.
+ */
+bool repartirTaches(int nbTaches, int nbFils, tache travail, void *donnees, bilanFil bilans[]);
+
+#endif
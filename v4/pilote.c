@@ -0,0 +1,704 @@
+/**
+ * @file pilote.c
+ * @brief Pilote automatique : recherche A* du plateau depuis la tête, parcours en largeur pour réparer le chemin gardé.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "pilote.h"
+
+/** @brief Touches rangées par INDICE_DIRECTION */
+#define TOUCHES_PILOTE "dqzs"
+/** @brief Case rendue par voisineAtteinte quand la voisine est interdite */
+#define CASE_INTERDITE UINT32_MAX
+/** @brief Seau sans case, et fin de la liste d'un seau */
+#define SEAU_VIDE UINT32_MAX
+/** @brief Bit de pilote->distance d'une case dont les voisines ont été vues */
+#define DEVELOPPEE 0x80000000u
+
+/** @typedef estimation
+ * @brief Données de la distance estimée à la pomme, calculées une fois par décision.
+ */
+typedef struct
+{
+    int pommeX;                  // position de la pomme
+    int pommeY;
+    int nombre;                  // téléporteurs ouverts qui rapprochent de la pomme
+    int entreeX[PORTAILS_MAX];   // entrée de chaque téléporteur ouvert
+    int entreeY[PORTAILS_MAX];
+    int reste[PORTAILS_MAX];     // distance sans obstacle de sa sortie à la pomme, téléporteurs compris
+} estimation;
+
+/**
+ * @brief Case où arrive la tête qui quitte une case dans une direction.
+ *
+ * @return Numéro de la case d'arrivée, téléporteur fait, ou CASE_INTERDITE pour une
+ *         bordure, un pavé ou le serpent.
+ */
+static uint32_t voisineAtteinte(const partie *jeu, uint32_t numeroCase, int indice);
+
+/**
+ * @brief Calcule les distances sans obstacle de la sortie de chaque téléporteur ouvert à la pomme.
+ *
+ * Un téléporteur mène de sa sortie à celle d'un autre en passant par son entrée :
+ * les distances sont raccourcies ainsi autant de fois qu'il y a de téléporteurs.
+ */
+static void preparerEstimation(estimation *bornes, const partie *jeu);
+
+/**
+ * @brief Distance sans obstacle d'une case à la pomme, téléporteurs compris.
+ *
+ * Elle ne dépasse jamais la vraie distance et change d'au plus un d'une case à sa
+ * voisine : la première fois qu'une case est développée, sa distance est la bonne.
+ *
+ * @param bornes Données de la décision.
+ * @param x Coordonnée X de la case.
+ * @param y Coordonnée Y de la case.
+ */
+static uint32_t estimer(const estimation *bornes, int x, int y);
+
+/**
+ * @brief Pas au moins pour passer par un téléporteur dont l'entrée est à (dx, dy) de la case.
+ */
+static int versEntree(int dx, int dy);
+
+/**
+ * @brief Range une case en tête d'un seau de la file de piloter.
+ */
+static void ranger(pilote *lui, uint32_t numeroCase, uint32_t niveau);
+
+/**
+ * @brief Retire une case du seau où elle est rangée.
+ */
+static void retirer(pilote *lui, uint32_t numeroCase, uint32_t niveau);
+
+/**
+ * @brief Touche de repli sans chemin : la direction courante si la case suivante est
+ *        libre, sinon la première voisine libre, sinon la direction courante.
+ */
+static char repli(const partie *jeu, uint32_t tete);
+
+/**
+ * @brief Indique si la pomme reste hors d'atteinte depuis le dernier parcours manqué.
+ *
+ * Les cases vues par ce parcours contiennent toutes celles que la tête atteignait. Elles
+ * les contiennent encore si la tête est restée parmi elles et si la seule case libérée
+ * depuis, l'ancienne queue, n'est atteinte depuis aucune d'elles. De même, la poche
+ * contient toutes les cases libres qui mènent à la pomme tant que ni la tête ni la case
+ * libérée n'y mènent. Chaque ensemble qui cesse de convenir est abandonné.
+ */
+static bool toujoursEnfermee(pilote *lui, const partie *jeu, uint32_t tete);
+
+/**
+ * @brief Parcours à rebours depuis la pomme : marque, de l'époque suivante, les cases
+ *        libres d'où l'on peut l'atteindre.
+ *
+ * @return false si le parcours dépasse limite cases (la poche n'est pas gardée).
+ */
+static bool entourerPomme(pilote *lui, const partie *jeu, uint32_t pomme, uint32_t limite);
+
+/**
+ * @brief Retient la preuve d'une pomme hors d'atteinte, après un parcours manqué qui
+ *        a vu toutes les cases que la tête atteint : ces cases, la poche de la pomme
+ *        et la queue du serpent, seule case qui peut se libérer au déplacement suivant.
+ */
+static void retenirImpasse(pilote *lui, const partie *jeu, uint32_t pomme);
+
+/**
+ * @brief Retient la taille du serpent et la case de sa queue, pour toujoursEnfermee.
+ */
+static void retenirQueue(pilote *lui, const partie *jeu);
+
+/**
+ * @brief Indique si une case mène en un pas dans la poche de la pomme.
+ */
+static bool menePoche(const pilote *lui, const partie *jeu, uint32_t numeroCase);
+
+/**
+ * @brief Parcours en largeur depuis la tête jusqu'à la pomme ou jusqu'à une case du
+ *        chemin gardé d'indice au moins reprise, puis raccorde le chemin trouvé à la
+ *        fin du chemin gardé.
+ *
+ * @return false si ni la pomme ni la fin du chemin gardé ne sont atteintes.
+ */
+static bool chercherChemin(pilote *lui, const partie *jeu, uint32_t tete, uint32_t pomme, uint32_t reprise);
+
+/*****************************************************
+ *                 PROCEDURE                         *
+ *****************************************************/
+bool creerPilote(pilote *lui, const partie *modele)
+{
+    memset(lui, 0, sizeof(*lui));
+    lui->file = malloc(modele->nbCases * sizeof(uint32_t));
+    lui->vue = calloc(modele->nbCases, sizeof(uint32_t));
+    lui->precedente = malloc(modele->nbCases * sizeof(uint32_t));
+    lui->chemin = malloc(modele->nbCases * sizeof(uint32_t));
+    lui->place = calloc(modele->nbCases, sizeof(uint32_t));
+    lui->touches = malloc(modele->nbCases);
+    lui->distance = malloc(modele->nbCases * sizeof(uint32_t));
+    lui->seaux = malloc(2 * (size_t)modele->nbCases * sizeof(uint32_t));
+    lui->apres = malloc(modele->nbCases * sizeof(uint32_t));
+    lui->avant = malloc(modele->nbCases * sizeof(uint32_t));
+    if ((lui->file == NULL) || (lui->vue == NULL) || (lui->precedente == NULL) || (lui->chemin == NULL)
+     || (lui->place == NULL) || (lui->touches == NULL) || (lui->distance == NULL) || (lui->seaux == NULL)
+     || (lui->apres == NULL) || (lui->avant == NULL))
+    {
+        detruirePilote(lui);
+        return false;
+    }
+    // un niveau de seau est au plus la distance parcourue plus l'estimation, deux fois nbCases
+    memset(lui->seaux, 0xff, 2 * (size_t)modele->nbCases * sizeof(uint32_t));
+    lui->nbCases = modele->nbCases;
+    return true;
+}
+
+void detruirePilote(pilote *lui)
+{
+    free(lui->file);
+    free(lui->vue);
+    free(lui->precedente);
+    free(lui->chemin);
+    free(lui->place);
+    free(lui->touches);
+    free(lui->distance);
+    free(lui->seaux);
+    free(lui->apres);
+    free(lui->avant);
+    memset(lui, 0, sizeof(*lui));
+}
+
+char piloter(pilote *lui, const partie *jeu)
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+    uint32_t tete = NUMERO_CASE(jeu, leSerpent->lesX[leSerpent->tete], leSerpent->lesY[leSerpent->tete]);
+    uint32_t pomme = NUMERO_CASE(jeu, jeu->pommeX, jeu->pommeY);
+    uint32_t *vue = lui->vue;
+    uint32_t *distance = lui->distance;
+    uint32_t *seaux = lui->seaux;
+    estimation bornes;
+    uint32_t marque;
+    uint32_t courante;
+    uint32_t arrivee;
+    uint32_t voisine;
+    uint32_t pas;
+    uint32_t niveau = 0;
+    uint32_t origine;
+    uint32_t estimee;
+    int premier;
+    uint32_t vues = 0;
+    int demiTour = INDICE_DIRECTION(jeu->direction) ^ 1; // 'd' et 'q', 'z' et 's' ne diffèrent que du bit du bas
+    int trouvee = -1;
+
+    // Pomme hors d'atteinte au déplacement précédent : elle le reste si la case libérée n'ouvre rien
+    lui->parcours++;
+    if (lui->impasse && (lui->jeu == jeu) && (lui->graine == jeu->graine) && (lui->numeroPomme == jeu->numeroPomme)
+     && toujoursEnfermee(lui, jeu, tete))
+    {
+        retenirQueue(lui, jeu);
+        return repli(jeu, tete);
+    }
+
+    // Nouvelle époque : les marques des parcours précédents sont toutes plus petites
+    if (lui->epoque == EPOQUE_MAX)
+    {
+        memset(vue, 0, lui->nbCases * sizeof(uint32_t));
+        lui->epoque = 0;
+    }
+    lui->epoque++;
+    marque = lui->epoque << 2;
+    vue[tete] = marque;
+    distance[tete] = DEVELOPPEE;
+    preparerEstimation(&bornes, jeu);
+    origine = estimer(&bornes, leSerpent->lesX[leSerpent->tete], leSerpent->lesY[leSerpent->tete]);
+    lui->plusHaut = 0;
+
+    // Premier pas : chaque voisine retient sa direction, le demi-tour est refusé par definirDirection
+    for (int i = 0; (i < 4) && (trouvee < 0); i++)
+    {
+        voisine = voisineAtteinte(jeu, tete, i);
+        if ((i == demiTour) || (voisine == CASE_INTERDITE) || (vue[voisine] >= marque))
+        {
+            continue;
+        }
+        if (voisine == pomme)
+        {
+            trouvee = i;
+            continue;
+        }
+        vue[voisine] = marque | (uint32_t)i;
+        vues++;
+        distance[voisine] = 1;
+        arrivee = jeu->arrivees[tete + jeu->ecarts[i]];
+        ranger(lui, voisine, 1 + estimer(&bornes, ARRIVEE_X(arrivee), ARRIVEE_Y(arrivee)) - origine);
+    }
+
+    // Les cases suivantes héritent du premier pas de la case d'où elles sont vues ; la plus petite
+    // distance estimée passe d'abord, la dernière rangée dans son seau en premier
+    while (trouvee < 0)
+    {
+        while ((niveau <= lui->plusHaut) && (seaux[niveau] == SEAU_VIDE))
+        {
+            niveau++;
+        }
+        if (niveau > lui->plusHaut)
+        {
+            break;
+        }
+        courante = seaux[niveau];
+        retirer(lui, courante, niveau);
+        pas = distance[courante] + 1;
+        distance[courante] |= DEVELOPPEE;
+        premier = (int)(vue[courante] & 3);
+        for (int i = 0; (i < 4) && (trouvee < 0); i++)
+        {
+            voisine = voisineAtteinte(jeu, courante, i);
+            // une case développée, ou vue d'aussi près, est laissée
+            if ((voisine == CASE_INTERDITE) || ((vue[voisine] >= marque) && ((distance[voisine] <= pas)
+             || ((distance[voisine] & DEVELOPPEE) != 0))))
+            {
+                continue;
+            }
+            if (voisine == pomme)
+            {
+                // l'estimation ne croît pas plus vite que la distance : aucun chemin restant n'est plus court
+                trouvee = premier;
+                continue;
+            }
+            // les coordonnées de la voisine, sans division, dans la table des arrivées
+            arrivee = jeu->arrivees[courante + jeu->ecarts[i]];
+            estimee = estimer(&bornes, ARRIVEE_X(arrivee), ARRIVEE_Y(arrivee));
+            if (vue[voisine] >= marque)
+            {
+                // chemin plus court vers une case vue mais pas encore développée
+                retirer(lui, voisine, distance[voisine] + estimee - origine);
+            }
+            else
+            {
+                vues++;
+            }
+            vue[voisine] = marque | (uint32_t)premier;
+            distance[voisine] = pas;
+            ranger(lui, voisine, pas + estimee - origine);
+        }
+    }
+
+    // Les seaux restent vides pour le parcours suivant : ceux d'avant niveau le sont déjà
+    for (uint32_t i = niveau; i <= lui->plusHaut; i++)
+    {
+        seaux[i] = SEAU_VIDE;
+    }
+    lui->impasse = trouvee < 0;
+    if (lui->impasse)
+    {
+        // la file s'est vidée : toutes les cases que la tête atteint ont été vues
+        lui->vues = vues + 1;
+        retenirImpasse(lui, jeu, pomme);
+        return repli(jeu, tete);
+    }
+    return TOUCHES_PILOTE[trouvee];
+}
+
+char planifier(pilote *lui, const partie *jeu)
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+    uint32_t tete = NUMERO_CASE(jeu, leSerpent->lesX[leSerpent->tete], leSerpent->lesY[leSerpent->tete]);
+    uint32_t pomme = NUMERO_CASE(jeu, jeu->pommeX, jeu->pommeY);
+    uint32_t *chemin = lui->chemin;
+    uint32_t reprise;
+    bool memePomme = (lui->jeu == jeu) && (lui->graine == jeu->graine) && (lui->numeroPomme == jeu->numeroPomme);
+
+    // Pomme hors d'atteinte au déplacement précédent : elle le reste si la case libérée n'ouvre rien
+    if (memePomme && (lui->longueur == 0) && toujoursEnfermee(lui, jeu, tete))
+    {
+        retenirQueue(lui, jeu);
+        lui->suivis++;
+        return repli(jeu, tete);
+    }
+    memePomme = memePomme && (lui->longueur > 0);
+
+    // La tête a fait le pas prévu au déplacement précédent
+    if (memePomme && (lui->etape + 1 < lui->longueur) && (chemin[lui->etape + 1] == tete))
+    {
+        lui->etape++;
+    }
+
+    // Chemin suivi : seul le prochain pas est vérifié
+    if (memePomme && (chemin[lui->etape] == tete)
+     && (lui->etape + 1 < lui->longueur)
+     && (voisineAtteinte(jeu, tete, INDICE_DIRECTION(lui->touches[lui->etape])) == chemin[lui->etape + 1]))
+    {
+        lui->suivis++;
+        return lui->touches[lui->etape];
+    }
+
+    if (memePomme)
+    {
+        // Réparation : la fin du chemin après sa dernière case prise est gardée, la pomme au moins
+        reprise = lui->longueur - 1;
+        while ((reprise > lui->etape) && !CASE_OCCUPEE(jeu, chemin[reprise - 1]))
+        {
+            reprise--;
+        }
+        lui->reparations++;
+    }
+    else
+    {
+        lui->longueur = 0;
+        reprise = 0;
+        lui->parcours++;
+    }
+    lui->jeu = jeu;
+    lui->graine = jeu->graine;
+    lui->numeroPomme = jeu->numeroPomme;
+    if (!chercherChemin(lui, jeu, tete, pomme, reprise))
+    {
+        lui->longueur = 0;
+        retenirImpasse(lui, jeu, pomme);
+        return repli(jeu, tete);
+    }
+    return lui->touches[0];
+}
+
+/*****************************************************
+ *                 BOITES A OUTILS                   *
+ *****************************************************/
+static void preparerEstimation(estimation *bornes, const partie *jeu)
+{
+    int sortieX[PORTAILS_MAX];
+    int sortieY[PORTAILS_MAX];
+    uint32_t entree;
+    int raccourci;
+    int utiles;
+
+    bornes->pommeX = jeu->pommeX;
+    bornes->pommeY = jeu->pommeY;
+    bornes->nombre = 0;
+    for (int k = 0; k < jeu->nombrePortails; k++)
+    {
+        entree = jeu->portails[k].entree;
+        if (jeu->destinations[entree] != DESTINATION_MUR)
+        {
+            bornes->entreeX[bornes->nombre] = CASE_X(jeu, entree);
+            bornes->entreeY[bornes->nombre] = CASE_Y(jeu, entree);
+            sortieX[bornes->nombre] = ARRIVEE_X(jeu->arrivees[entree]);
+            sortieY[bornes->nombre] = ARRIVEE_Y(jeu->arrivees[entree]);
+            bornes->reste[bornes->nombre] = abs(sortieX[bornes->nombre] - jeu->pommeX)
+                                          + abs(sortieY[bornes->nombre] - jeu->pommeY);
+            bornes->nombre++;
+        }
+    }
+    for (int tour = 1; tour < bornes->nombre; tour++)
+    {
+        for (int k = 0; k < bornes->nombre; k++)
+        {
+            for (int j = 0; j < bornes->nombre; j++)
+            {
+                raccourci = versEntree(sortieX[k] - bornes->entreeX[j], sortieY[k] - bornes->entreeY[j]) + bornes->reste[j];
+                if (raccourci < bornes->reste[k])
+                {
+                    bornes->reste[k] = raccourci;
+                }
+            }
+        }
+    }
+
+    // un téléporteur dont la sortie n'est pas plus près de la pomme que l'entrée n'améliore aucune case
+    utiles = 0;
+    for (int k = 0; k < bornes->nombre; k++)
+    {
+        if (bornes->reste[k] < abs(bornes->entreeX[k] - jeu->pommeX) + abs(bornes->entreeY[k] - jeu->pommeY))
+        {
+            bornes->entreeX[utiles] = bornes->entreeX[k];
+            bornes->entreeY[utiles] = bornes->entreeY[k];
+            bornes->reste[utiles] = bornes->reste[k];
+            utiles++;
+        }
+    }
+    bornes->nombre = utiles;
+}
+
+static int versEntree(int dx, int dy)
+{
+    // atteindre une voisine de l'entrée puis y entrer ; depuis l'entrée même, en sortir puis y revenir
+    int pas = abs(dx) + abs(dy);
+
+    return (pas == 0) ? 2 : pas;
+}
+
+static uint32_t estimer(const estimation *bornes, int x, int y)
+{
+    int estimee = abs(x - bornes->pommeX) + abs(y - bornes->pommeY);
+    int parPortail;
+
+    for (int k = 0; k < bornes->nombre; k++)
+    {
+        parPortail = versEntree(x - bornes->entreeX[k], y - bornes->entreeY[k]) + bornes->reste[k];
+        if (parPortail < estimee)
+        {
+            estimee = parPortail;
+        }
+    }
+    return (uint32_t)estimee;
+}
+
+static void ranger(pilote *lui, uint32_t numeroCase, uint32_t niveau)
+{
+    uint32_t premiere = lui->seaux[niveau];
+
+    lui->apres[numeroCase] = premiere;
+    lui->avant[numeroCase] = SEAU_VIDE;
+    if (premiere != SEAU_VIDE)
+    {
+        lui->avant[premiere] = numeroCase;
+    }
+    lui->seaux[niveau] = numeroCase;
+    if (niveau > lui->plusHaut)
+    {
+        lui->plusHaut = niveau;
+    }
+}
+
+static void retirer(pilote *lui, uint32_t numeroCase, uint32_t niveau)
+{
+    uint32_t avant = lui->avant[numeroCase];
+    uint32_t apres = lui->apres[numeroCase];
+
+    if (avant == SEAU_VIDE)
+    {
+        lui->seaux[niveau] = apres;
+    }
+    else
+    {
+        lui->apres[avant] = apres;
+    }
+    if (apres != SEAU_VIDE)
+    {
+        lui->avant[apres] = avant;
+    }
+}
+
+static uint32_t voisineAtteinte(const partie *jeu, uint32_t numeroCase, int indice)
+{
+    // une lecture pour la case d'arrivée, une pour le masque des cases occupées
+    uint32_t voisine = jeu->destinations[numeroCase + jeu->ecarts[indice]];
+
+    if ((voisine == DESTINATION_MUR) || CASE_OCCUPEE(jeu, voisine))
+    {
+        return CASE_INTERDITE;
+    }
+    return voisine;
+}
+
+static bool toujoursEnfermee(pilote *lui, const partie *jeu, uint32_t tete)
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+    uint32_t liberee = lui->queueImpasse;
+    bool libre;
+
+    // Le serpent a grandi, ou un autre segment couvre encore l'ancienne queue : aucune case libérée
+    if ((leSerpent->taille != lui->tailleImpasse) && (leSerpent->taille != lui->tailleImpasse + 1))
+    {
+        return false;
+    }
+    libre = (leSerpent->taille == lui->tailleImpasse) && (leSerpent->occupation[liberee] == 0);
+
+    // Les cases vues : la tête y reste, la case libérée n'est atteinte depuis aucune d'elles
+    lui->enclos = lui->enclos && ((lui->vue[tete] >> 2) == lui->epoqueImpasse);
+    for (int k = 0; libre && lui->enclos && (k < jeu->nombrePortails); k++)
+    {
+        lui->enclos = jeu->portails[k].sortie != liberee;
+    }
+    for (int i = 0; libre && lui->enclos && (i < 4); i++)
+    {
+        lui->enclos = (lui->vue[liberee - jeu->ecarts[i]] >> 2) != lui->epoqueImpasse;
+    }
+
+    // La poche : ni la tête ni la case libérée n'y mènent
+    lui->poche = lui->poche && !menePoche(lui, jeu, tete) && !(libre && menePoche(lui, jeu, liberee));
+    return lui->enclos || lui->poche;
+}
+
+static bool entourerPomme(pilote *lui, const partie *jeu, uint32_t pomme, uint32_t limite)
+{
+    uint32_t *file = lui->file;
+    uint32_t *vue = lui->vue;
+    uint32_t marque;
+    uint32_t courante;
+    uint32_t precedente;
+    uint32_t debut = 0;
+    uint32_t fin = 0;
+
+    // l'époque du parcours manqué doit rester dans vue : pas d'effacement ici
+    if (lui->epoque == EPOQUE_MAX)
+    {
+        return false;
+    }
+    lui->epoque++;
+    marque = lui->epoque << 2;
+    vue[pomme] = marque;
+    file[fin++] = pomme;
+    while ((debut < fin) && (fin <= limite))
+    {
+        courante = file[debut++];
+        // on arrive sur une case par sa voisine, sauf sur une ouverture, où l'on arrive par téléporteur
+        for (int i = 0; (i < 4) && (jeu->destinations[courante] == courante); i++)
+        {
+            precedente = courante - jeu->ecarts[i];
+            if ((vue[precedente] < marque) && (jeu->destinations[precedente] != DESTINATION_MUR)
+             && !CASE_OCCUPEE(jeu, precedente))
+            {
+                vue[precedente] = marque;
+                file[fin++] = precedente;
+            }
+        }
+        for (int k = 0; k < jeu->nombrePortails; k++)
+        {
+            for (int i = 0; (i < 4) && (jeu->portails[k].sortie == courante); i++)
+            {
+                precedente = jeu->portails[k].entree - jeu->ecarts[i];
+                if ((vue[precedente] < marque) && (jeu->destinations[precedente] != DESTINATION_MUR)
+                 && !CASE_OCCUPEE(jeu, precedente))
+                {
+                    vue[precedente] = marque;
+                    file[fin++] = precedente;
+                }
+            }
+        }
+    }
+    return debut == fin;
+}
+
+static bool menePoche(const pilote *lui, const partie *jeu, uint32_t numeroCase)
+{
+    uint32_t voisine;
+    bool mene = false;
+
+    for (int i = 0; !mene && (i < 4); i++)
+    {
+        voisine = jeu->destinations[numeroCase + jeu->ecarts[i]];
+        mene = (voisine != DESTINATION_MUR) && ((lui->vue[voisine] >> 2) == lui->epoqueImpasse + 1);
+    }
+    return mene;
+}
+
+static void retenirImpasse(pilote *lui, const partie *jeu, uint32_t pomme)
+{
+    lui->jeu = jeu;
+    lui->graine = jeu->graine;
+    lui->numeroPomme = jeu->numeroPomme;
+    lui->epoqueImpasse = lui->epoque;
+    lui->enclos = true;
+    lui->poche = entourerPomme(lui, jeu, pomme, lui->vues);
+    retenirQueue(lui, jeu);
+}
+
+static void retenirQueue(pilote *lui, const partie *jeu)
+{
+    const serpent *leSerpent = &jeu->leSerpent;
+
+    lui->tailleImpasse = leSerpent->taille;
+    lui->queueImpasse = NUMERO_CASE(jeu, leSerpent->lesX[indiceSegment(leSerpent, leSerpent->taille - 1)],
+                                    leSerpent->lesY[indiceSegment(leSerpent, leSerpent->taille - 1)]);
+}
+
+static char repli(const partie *jeu, uint32_t tete)
+{
+    int demiTour = INDICE_DIRECTION(jeu->direction) ^ 1;
+    char touche = jeu->direction;
+    bool trouvee = false;
+
+    for (int i = 0; i < 4; i++)
+    {
+        if ((i != demiTour) && (voisineAtteinte(jeu, tete, i) != CASE_INTERDITE)
+         && (!trouvee || (TOUCHES_PILOTE[i] == jeu->direction)))
+        {
+            touche = TOUCHES_PILOTE[i];
+            trouvee = true;
+        }
+    }
+    return touche;
+}
+
+static bool chercherChemin(pilote *lui, const partie *jeu, uint32_t tete, uint32_t pomme, uint32_t reprise)
+{
+    uint32_t *file = lui->file;
+    uint32_t *vue = lui->vue;
+    uint32_t *precedente = lui->precedente;
+    uint32_t *chemin = lui->chemin;
+    uint32_t *place = lui->place;
+    uint32_t marque;
+    uint32_t courante;
+    uint32_t voisine;
+    uint32_t debut = 0;
+    uint32_t fin = 0;
+    uint32_t cible = CASE_INTERDITE;
+    uint32_t pas = 0;
+    uint32_t gardees = 0;
+    int demiTour = INDICE_DIRECTION(jeu->direction) ^ 1;
+
+    if (lui->epoque == EPOQUE_MAX)
+    {
+        memset(vue, 0, lui->nbCases * sizeof(uint32_t));
+        lui->epoque = 0;
+    }
+    lui->epoque++;
+    marque = lui->epoque << 2;
+    vue[tete] = marque;
+    file[fin++] = tete;
+
+    // Chaque case retient d'où elle a été vue ; la première case cible arrête le parcours
+    while ((debut < fin) && (cible == CASE_INTERDITE))
+    {
+        courante = file[debut++];
+        for (int i = 0; (i < 4) && (cible == CASE_INTERDITE); i++)
+        {
+            voisine = voisineAtteinte(jeu, courante, i);
+            if (((courante == tete) && (i == demiTour)) || (voisine == CASE_INTERDITE) || (vue[voisine] >= marque))
+            {
+                continue;
+            }
+            vue[voisine] = marque;
+            precedente[voisine] = (courante << 2) | (uint32_t)i;
+            file[fin++] = voisine;
+            if ((voisine == pomme)
+             || ((place[voisine] < lui->longueur) && (chemin[place[voisine]] == voisine) && (place[voisine] >= reprise)))
+            {
+                cible = voisine;
+            }
+        }
+    }
+    lui->vues = fin;
+    if (cible == CASE_INTERDITE)
+    {
+        return false;
+    }
+
+    // La fin du chemin gardé, après la cible, est décalée derrière les pas trouvés
+    for (uint32_t numeroCase = cible; numeroCase != tete; numeroCase = precedente[numeroCase] >> 2)
+    {
+        pas++;
+    }
+    if (cible != pomme)
+    {
+        gardees = lui->longueur - 1 - place[cible];
+        memmove(chemin + pas + 1, chemin + place[cible] + 1, gardees * sizeof(uint32_t));
+        memmove(lui->touches + pas, lui->touches + place[cible], gardees);
+    }
+    for (uint32_t i = pas, numeroCase = cible; i > 0; i--, numeroCase = precedente[numeroCase] >> 2)
+    {
+        chemin[i] = numeroCase;
+        lui->touches[i - 1] = TOUCHES_PILOTE[precedente[numeroCase] & 3];
+    }
+    chemin[0] = tete;
+    lui->longueur = pas + 1 + gardees;
+    lui->etape = 0;
+    for (uint32_t i = 0; i < lui->longueur; i++)
+    {
+        place[chemin[i]] = i;
+    }
+    return true;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file pilote.h
+ * @brief Pilote automatique : plus court chemin de la tête à la pomme, téléporteurs compris.
+ *
+ * À chaque déplacement, piloter cherche le plateau depuis la tête en développant
+ * d'abord les cases dont la distance parcourue plus la distance estimée à la pomme est
+ * la plus petite (A*). L'estimation ignore les obstacles mais pas les téléporteurs
+ * ouverts qui rapprochent de la pomme : elle ne surestime jamais et la première case
+ * développée de chaque niveau est à la bonne distance. Le pas d'une case à sa voisine
+ * lit la table des destinations de la partie (téléporteur fait, ou mur) puis le bit de
+ * la voisine dans la table des cases occupées (pavé ou serpent). La recherche s'arrête
+ * dès qu'elle atteint la pomme et donne la touche du premier pas du chemin.
+ *
+ * Les tableaux de la recherche sont alloués une fois, aux dimensions de la partie :
+ * une file rangée en seaux, un par niveau, et, pour chaque case, l'époque de la
+ * dernière recherche qui l'a vue. Une recherche commence en changeant d'époque, sans
+ * effacer les tableaux. Une pomme hors d'atteinte n'est pas cherchée de nouveau tant
+ * que sa preuve tient, comme pour planifier (plus bas). Une décision de piloter coûte
+ * environ 1 µs sur le plateau par défaut et 3 à 4 µs sur 300 x 200 avec un serpent de
+ * 2000 segments (banc --pilote) : moins d'un million de décisions par seconde. Seul
+ * planifier, qui ne cherche qu'à chaque pomme, descend à quelques centaines de ns.
+ *
+ * planifier garde au contraire le chemin trouvé d'un déplacement à l'autre. Tant que
+ * la tête le suit et que la pomme ne change pas, il reste sûr : le corps n'occupe que
+ * des cases déjà parcourues et la queue ne fait que libérer les siennes. Le prochain
+ * pas est seulement vérifié. Si la tête s'en écarte (une touche du joueur), le chemin
+ * est réparé : un parcours depuis la tête s'arrête à la première case intacte de la
+ * fin de l'ancien chemin, qui est gardée. Seule une nouvelle pomme demande un parcours
+ * jusqu'à elle ; les pavés ne sont posés qu'au passage de niveau, qui suit toujours
+ * une pomme mangée : un chemin gardé ne les croise jamais. Le chemin gardé reste sûr
+ * mais peut devenir plus long que le plus court, quand la queue libère un raccourci.
+ *
+ * Une pomme hors d'atteinte n'est pas cherchée de nouveau tant que la tête reste dans
+ * les cases vues par le parcours manqué, ou que la pomme reste dans sa poche (les cases
+ * d'où on l'atteint, trouvées par un parcours à rebours) : seule la case libérée par la
+ * queue à chaque déplacement est vérifiée. piloter et planifier doivent donc être
+ * appelés à chaque déplacement, et un même pilote ne sert qu'à l'un des deux.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#ifndef PILOTE_H
+#define PILOTE_H
+
+#include "libsnake.h"
+
+/** @brief Époques possibles avant d'effacer pilote->vue : les deux bits du bas gardent une direction */
+#define EPOQUE_MAX (UINT32_MAX >> 2)
+
+/** @typedef pilote
+ * @brief Tableaux d'un parcours, aux dimensions d'une partie.
+ */
+typedef struct
+{
+    uint32_t nbCases;       // cases de la partie modèle
+    uint32_t *file;         // cases à visiter, nbCases cases
+    uint32_t *vue;          // (époque << 2) | INDICE_DIRECTION du premier pas, nbCases cases
+    uint32_t epoque;        // époque du dernier parcours, de 1 à EPOQUE_MAX
+    long parcours;          // nombre de parcours jusqu'à la pomme
+    uint32_t *precedente;   // (case d'où elle a été vue << 2) | INDICE_DIRECTION du pas, nbCases cases
+    uint32_t *chemin;       // chemin gardé par planifier, de la tête à la pomme, nbCases cases
+    uint32_t *place;        // indice de chaque case dans chemin, valable si chemin[place[c]] == c
+    char *touches;          // touche du pas de chemin[i] à chemin[i + 1]
+    uint32_t longueur;      // cases du chemin, 0 sans chemin
+    uint32_t etape;         // indice de la tête dans le chemin
+    const partie *jeu;      // partie et pomme du chemin trouvé ou de la pomme hors d'atteinte
+    uint64_t graine;
+    int numeroPomme;
+    uint32_t vues;          // cases vues par le dernier parcours
+    uint32_t epoqueImpasse; // époque du dernier parcours qui n'a pas atteint la pomme
+    bool enclos;            // cases vues par ce parcours : toutes celles que la tête atteint y sont
+    bool poche;             // cases qui mènent à la pomme toutes marquées, de l'époque epoqueImpasse + 1
+    int tailleImpasse;      // taille du serpent et case de sa queue au déplacement précédent, pomme hors d'atteinte
+    uint32_t queueImpasse;
+    long reparations;       // nombre de chemins réparés
+    long suivis;            // nombre de pas joués sans parcours
+    uint32_t *distance;     // pas depuis la tête de chaque case vue par piloter, | DEVELOPPEE, nbCases cases
+    uint32_t *seaux;        // première case de chaque niveau (distance + estimation) de la file de piloter
+    uint32_t *apres;        // cases suivante et précédente dans leur seau, nbCases cases
+    uint32_t *avant;
+    uint32_t plusHaut;      // plus haut niveau rangé par le parcours en cours
+    bool impasse;           // le dernier piloter n'a pas trouvé de chemin
+} pilote;
+
+/**
+ * @brief Alloue un pilote aux dimensions d'une partie.
+ *
+ * @param lui Pilote à allouer.
+ * @param modele Partie dont les dimensions sont reprises.
+ * @return false si la mémoire manque (le pilote est alors vide).
+ */
+bool creerPilote(pilote *lui, const partie *modele);
+
+/**
+ * @brief Libère la mémoire d'un pilote.
+ *
+ * @param lui Pilote à libérer.
+ */
+void detruirePilote(pilote *lui);
+
+/**
+ * @brief Choisit la touche du prochain déplacement.
+ *
+ * Sans chemin jusqu'à la pomme, le pilote garde sa direction si la case suivante
+ * est libre, sinon prend la première voisine libre, sinon garde sa direction.
+ *
+ * @param lui Pilote aux dimensions de la partie.
+ * @param jeu Partie en cours.
+ * @return Touche du premier pas du plus court chemin vers la pomme.
+ */
+char piloter(pilote *lui, const partie *jeu);
+
+/**
+ * @brief Choisit la touche du prochain déplacement en suivant, ou en réparant, le chemin gardé.
+ *
+ * Sans chemin jusqu'à la pomme, le pilote se replie comme piloter et oublie son chemin.
+ *
+ * @param lui Pilote aux dimensions de la partie.
+ * @param jeu Partie en cours.
+ * @return Touche du prochain pas du chemin gardé.
+ */
+char planifier(pilote *lui, const partie *jeu);
+
+#endif
@@ -0,0 +1,212 @@
+/**
+ * @file preparation.c
+ * @brief Fil d'exécution qui tire d'avance le pavage du prochain passage de niveau.
+ *
+ * Le fil remplit toujours le pavage qui n'est pas publié, puis le publie sous le
+ * verrou : la partie ne voit jamais un pavage à moitié tiré. Tant que la partie lit
+ * le pavage publié (entre livrerPavage et la commande suivante), le fil n'en
+ * commence pas d'autre.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#define _GNU_SOURCE     // SCHED_IDLE
+
+#include <stdlib.h>
+#include <string.h>
+#include "preparation.h"
+
+/**
+ * @brief Boucle du fil : attend une commande, tire le pavage, le publie.
+ *
+ * @param argument Préparation du fil.
+ * @return NULL.
+ */
+static void *preparer(void *argument);
+
+/**
+ * @brief Remet dans le plateau du fil les bordures, les obstacles du décor et les pavés de la commande.
+ *
+ * @param plan Partie du fil, dont plan->coinsPaves contient les coins des pavés et plan->decor le décor.
+ * @param nombrePaves Nombre de pavés.
+ */
+static void dessinerPlan(partie *plan, int nombrePaves);
+
+/*****************************************************
+ *                 PROCEDURE                         *
+ *****************************************************/
+bool creerPreparation(preparation *prepa, const partie *modele)
+{
+    parametres config;
+    struct sched_param priorite = {0};
+    bool cree;
+
+    memset(prepa, 0, sizeof(*prepa));
+    prepa->publie = -1;
+    parametresParDefaut(&config);
+    config.largeur = modele->largeur;
+    config.hauteur = modele->hauteur;
+    config.tailleMax = TAILLE_SERPENT_INITIAL; // le fil n'a pas de serpent
+    cree = creerPartie(&prepa->plan, &config);
+    prepa->coinsPaves = cree ? malloc(PAVES_POSSIBLES(modele) * sizeof(uint32_t)) : NULL;
+    cree = (prepa->coinsPaves != NULL) && creerPavage(&prepa->pavages[0], modele)
+        && creerPavage(&prepa->pavages[1], modele);
+    if (cree)
+    {
+        pthread_mutex_init(&prepa->verrou, NULL);
+        pthread_cond_init(&prepa->signal, NULL);
+        pthread_cond_init(&prepa->fini, NULL);
+        cree = pthread_create(&prepa->fil, NULL, preparer, prepa) == 0;
+        if (!cree)
+        {
+            pthread_mutex_destroy(&prepa->verrou);
+            pthread_cond_destroy(&prepa->signal);
+            pthread_cond_destroy(&prepa->fini);
+        }
+#ifdef SCHED_IDLE
+        else
+        {
+            // le fil ne prend jamais le processeur à la partie : sans effet si le système refuse
+            pthread_setschedparam(prepa->fil, SCHED_IDLE, &priorite);
+        }
+#endif
+    }
+    if (!cree)
+    {
+        detruirePartie(&prepa->plan);
+        free(prepa->coinsPaves);
+        detruirePavage(&prepa->pavages[0]);
+        detruirePavage(&prepa->pavages[1]);
+        memset(prepa, 0, sizeof(*prepa));
+    }
+    return cree;
+}
+
+void detruirePreparation(preparation *prepa)
+{
+    pthread_mutex_lock(&prepa->verrou);
+    prepa->arret = true;
+    pthread_cond_signal(&prepa->signal);
+    pthread_mutex_unlock(&prepa->verrou);
+    pthread_join(prepa->fil, NULL);
+
+    pthread_mutex_destroy(&prepa->verrou);
+    pthread_cond_destroy(&prepa->signal);
+    pthread_cond_destroy(&prepa->fini);
+    detruirePartie(&prepa->plan);
+    free(prepa->coinsPaves);
+    detruirePavage(&prepa->pavages[0]);
+    detruirePavage(&prepa->pavages[1]);
+    memset(prepa, 0, sizeof(*prepa));
+}
+
+void commanderPavage(void *atelier, const partie *jeu)
+{
+    preparation *prepa = atelier;
+
+    pthread_mutex_lock(&prepa->verrou);
+    prepa->graine = jeu->graine;
+    prepa->level = jeu->level;
+    prepa->clePaves = jeu->clePaves;
+    prepa->decor = jeu->decor;
+    prepa->nombrePaves = jeu->nombrePaves;
+    prepa->tailleSerpent = jeu->tailleSerpent;
+    memcpy(prepa->coinsPaves, jeu->coinsPaves, jeu->nombrePaves * sizeof(uint32_t));
+    prepa->commande = true;
+    prepa->emprunte = false; // la partie a fini de poser le pavage qu'elle avait pris
+    pthread_cond_signal(&prepa->signal);
+    pthread_mutex_unlock(&prepa->verrou);
+}
+
+const pavage *livrerPavage(void *atelier)
+{
+    preparation *prepa = atelier;
+    const pavage *pret = NULL;
+
+    pthread_mutex_lock(&prepa->verrou);
+    if (prepa->publie >= 0)
+    {
+        pret = &prepa->pavages[prepa->publie];
+        prepa->emprunte = true;
+    }
+    pthread_mutex_unlock(&prepa->verrou);
+    return pret;
+}
+
+void attendrePavage(preparation *prepa)
+{
+    pthread_mutex_lock(&prepa->verrou);
+    // une commande qui attend derrière un pavage emprunté ne sera pas commencée : pas d'attente
+    while ((prepa->commande && !prepa->emprunte) || prepa->enCours)
+    {
+        pthread_cond_wait(&prepa->fini, &prepa->verrou);
+    }
+    pthread_mutex_unlock(&prepa->verrou);
+}
+
+/*****************************************************
+ *                 BOITES A OUTILS                   *
+ *****************************************************/
+static void *preparer(void *argument)
+{
+    preparation *prepa = argument;
+    partie *plan = &prepa->plan;
+    uint64_t graine;
+    int level, nombrePaves, tailleSerpent, cible;
+
+    pthread_mutex_lock(&prepa->verrou);
+    while (!prepa->arret)
+    {
+        if (prepa->commande && !prepa->emprunte)
+        {
+            // la commande est copiée : la partie peut en déposer une autre pendant le tirage
+            graine = prepa->graine;
+            level = prepa->level;
+            nombrePaves = prepa->nombrePaves;
+            tailleSerpent = prepa->tailleSerpent;
+            plan->clePaves = prepa->clePaves;
+            plan->decor = prepa->decor;
+            memcpy(plan->coinsPaves, prepa->coinsPaves, nombrePaves * sizeof(uint32_t));
+            prepa->commande = false;
+            prepa->enCours = true;
+            cible = (prepa->publie == 0) ? 1 : 0;
+            pthread_mutex_unlock(&prepa->verrou);
+
+            dessinerPlan(plan, nombrePaves);
+            tirerPavage(plan, graine, level, nombrePaves, tailleSerpent, false, &prepa->pavages[cible]);
+
+            pthread_mutex_lock(&prepa->verrou);
+            prepa->publie = cible;
+            prepa->enCours = false;
+            pthread_cond_broadcast(&prepa->fini);
+            prepa->tires++;
+        }
+        else
+        {
+            pthread_cond_wait(&prepa->signal, &prepa->verrou);
+        }
+    }
+    pthread_mutex_unlock(&prepa->verrou);
+    return NULL;
+}
+
+static void dessinerPlan(partie *plan, int nombrePaves)
+{
+    int x, y;
+
+    initBordures(plan);
+    for (int i = 0; i < nombrePaves; i++)
+    {
+        x = CASE_X(plan, plan->coinsPaves[i]);
+        y = CASE_Y(plan, plan->coinsPaves[i]);
+        for (int dy = 0; dy < TAILLE_PAVES_Y; dy++)
+        {
+            for (int dx = 0; dx < TAILLE_PAVES_X; dx++)
+            {
+                plan->plateau[NUMERO_CASE(plan, x + dx, y + dy)] = PAVES;
+            }
+        }
+    }
+}
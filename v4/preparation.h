@@ -0,0 +1,107 @@
+/**
+ * @file preparation.h
+ * @brief Tirage d'avance, par un fil d'exécution à part, du pavage du prochain passage de niveau.
+ *
+ * Quand les pavés d'un niveau sont posés, la partie commande le pavage du passage
+ * suivant (commanderPavage) ; le fil le tire pendant que la partie continue. Au
+ * passage de niveau, la partie prend le pavage prêt (livrerPavage) et n'a plus qu'à
+ * poser les pavés. Un pavage pas encore prêt est tiré sur place : le tirage ne
+ * dépend que de la graine, du niveau et des pavés déjà posés, le résultat est le même.
+ *
+ * Une préparation sert une seule partie à la fois :
+ *
+ *     creerPreparation(&prepa, &jeu);
+ *     config.commander = commanderPavage;
+ *     config.livrer = livrerPavage;
+ *     config.atelier = &prepa;
+ *     initPartie(&jeu, graine, &config);
+ *
+ * Le fil tourne en priorité d'inactivité (SCHED_IDLE, sous Linux) : il ne prend que
+ * le temps que la partie laisse, entre deux déplacements, et ne retarde jamais un
+ * déplacement, même sur un seul processeur. Une partie qui ne s'arrête jamais entre
+ * deux déplacements (banc) attend le fil avec attendrePavage pour mesurer un passage
+ * de niveau dont le pavage est prêt.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#ifndef PREPARATION_H
+#define PREPARATION_H
+
+#include <pthread.h>
+#include "libsnake.h"
+
+/** @typedef preparation
+ * @brief Fil qui tire les pavages et ce qu'il partage avec la partie.
+ */
+typedef struct
+{
+    pthread_t fil;
+    pthread_mutex_t verrou;  // protège tout ce qui suit
+    pthread_cond_t signal;   // une commande est arrivée, ou l'arrêt est demandé
+    pthread_cond_t fini;     // le fil a publié un pavage
+    bool commande;           // une commande attend le fil
+    bool enCours;            // le fil tire un pavage
+    bool arret;
+    bool emprunte;           // la partie lit le pavage publié : le fil n'en commence pas d'autre
+    uint64_t graine;         // commande en attente
+    int level;
+    uint64_t clePaves;
+    const decor *decor;      // obstacles posés avant les pavés, NULL pour le plateau par défaut
+    int nombrePaves;
+    int tailleSerpent;       // taille du serpent au prochain passage : fixe la marge du pavage
+    uint32_t *coinsPaves;    // pavés déjà posés, PAVES_POSSIBLES cases
+    partie plan;             // plateau et tampons du fil, pavés seulement
+    pavage pavages[2];       // le pavage publié et celui que le fil remplit
+    int publie;              // indice du pavage publié, -1 avant le premier
+    long tires;              // nombre de pavages tirés par le fil
+} preparation;
+
+/**
+ * @brief Alloue une préparation aux dimensions d'une partie et lance son fil.
+ *
+ * Le fil a son propre plateau : la mémoire d'une partie est à peu près doublée.
+ *
+ * @param prepa Préparation à créer.
+ * @param modele Partie dont les dimensions sont reprises.
+ * @return false si la mémoire manque ou si le fil n'a pas pu être créé.
+ */
+bool creerPreparation(preparation *prepa, const partie *modele);
+
+/**
+ * @brief Arrête le fil d'une préparation et libère sa mémoire.
+ *
+ * @param prepa Préparation à détruire.
+ */
+void detruirePreparation(preparation *prepa);
+
+/**
+ * @brief Commande le pavage du prochain passage de niveau (commandePavage).
+ *
+ * Copie la graine, le niveau et les coins des pavés de la partie : la partie peut
+ * ensuite continuer, être restaurée ou recommencée sans attendre le fil. Une
+ * commande pas encore commencée est remplacée par la nouvelle.
+ *
+ * @param atelier Préparation (preparation *).
+ * @param jeu Partie dont les pavés viennent d'être posés.
+ */
+void commanderPavage(void *atelier, const partie *jeu);
+
+/**
+ * @brief Rend le dernier pavage tiré par le fil (livraisonPavage), sans attendre.
+ *
+ * @param atelier Préparation (preparation *).
+ * @return Dernier pavage publié, NULL s'il n'y en a pas encore.
+ */
+const pavage *livrerPavage(void *atelier);
+
+/**
+ * @brief Attend que le fil ait tiré le pavage de la dernière commande.
+ *
+ * @param prepa Préparation dont la partie vient de commander un pavage.
+ */
+void attendrePavage(preparation *prepa);
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ * @file recherche.c
+ * @brief Clichés d'une partie, réserve de clichés et table de transposition.
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "recherche.h"
+
+/**
+ * @brief Arrondit une taille au multiple de ALIGNEMENT_CLICHE supérieur.
+ */
+static size_t arrondir(size_t taille);
+
+/**
+ * @brief Donne au cliché les dimensions du modèle et place ses tableaux dans memoire,
+ *        bloc de tailleCliche(modele) octets.
+ */
+static void lierCliche(cliche *photo, const partie *modele, unsigned char *memoire);
+
+/*****************************************************
+ *                 PROCEDURE                         *
+ *****************************************************/
+size_t tailleCliche(const partie *modele)
+{
+    // pas de positions pour les cases libres : restaurer les recalcule depuis les numéros
+    return 2 * arrondir(modele->nbCases)
+         + arrondir(MOTS_DECOR(modele->largeur, modele->hauteur) * sizeof(uint64_t))
+         + 2 * arrondir(modele->leSerpent.tailleMax * sizeof(int))
+         + arrondir(modele->nbCases * TAILLE_INDICE(modele->nbCases))
+         + arrondir(PAVES_POSSIBLES(modele) * sizeof(uint32_t));
+}
+
+bool creerCliche(cliche *photo, const partie *modele)
+{
+    unsigned char *memoire = aligned_alloc(ALIGNEMENT_CLICHE, tailleCliche(modele));
+
+    memset(photo, 0, sizeof(*photo));
+    if (memoire != NULL)
+    {
+        lierCliche(photo, modele, memoire);
+        photo->memoire = memoire;
+    }
+    return memoire != NULL;
+}
+
+void detruireCliche(cliche *photo)
+{
+    free(photo->memoire);
+    memset(photo, 0, sizeof(*photo));
+}
+
+void photographier(const partie *jeu, cliche *photo)
+{
+    copierEtat(&photo->etat, jeu);
+}
+
+void restaurer(partie *jeu, const cliche *photo)
+{
+    // dessiner, contexte et chrono ne font pas partie de l'état et ne sont pas écrasés
+    copierEtat(jeu, &photo->etat);
+}
+
+bool creerReserve(reserve *laReserve, int capacite, const partie *modele)
+{
+    bool cree;
+
+    memset(laReserve, 0, sizeof(*laReserve));
+    laReserve->tailleCliche = tailleCliche(modele);
+    if (capacite > 0)
+    {
+        laReserve->cliches = calloc(capacite, sizeof(cliche));
+        laReserve->memoire = aligned_alloc(ALIGNEMENT_CLICHE, capacite * laReserve->tailleCliche);
+    }
+    cree = (laReserve->cliches != NULL) && (laReserve->memoire != NULL);
+    if (cree)
+    {
+        // les tableaux d'un cliché se suivent : le prendre ne touche qu'un bloc contigu
+        for (int i = 0; i < capacite; i++)
+        {
+            lierCliche(&laReserve->cliches[i], modele, laReserve->memoire + i * laReserve->tailleCliche);
+        }
+        laReserve->capacite = capacite;
+    }
+    else
+    {
+        detruireReserve(laReserve);
+    }
+    return cree;
+}
+
+void detruireReserve(reserve *laReserve)
+{
+    free(laReserve->cliches);
+    free(laReserve->memoire);
+    memset(laReserve, 0, sizeof(*laReserve));
+}
+
+cliche *prendreCliche(reserve *laReserve, const partie *jeu)
+{
+    cliche *photo = NULL;
+
+    if (laReserve->nombre < laReserve->capacite)
+    {
+        photo = &laReserve->cliches[laReserve->nombre++];
+        photographier(jeu, photo);
+    }
+    return photo;
+}
+
+void rendreCliches(reserve *laReserve, int nombre)
+{
+    if ((nombre >= 0) && (nombre < laReserve->nombre))
+    {
+        laReserve->nombre = nombre;
+    }
+}
+
+bool creerTable(tableTransposition *table, int bits)
+{
+    size_t nombre = (size_t)1 << bits;
+
+    table->entrees = ((bits >= 0) && (bits < 32)) ? malloc(nombre * sizeof(entreeTable)) : NULL;
+    table->masque = (table->entrees != NULL) ? nombre - 1 : 0;
+    viderTable(table);
+    return table->entrees != NULL;
+}
+
+void detruireTable(tableTransposition *table)
+{
+    free(table->entrees);
+    table->entrees = NULL;
+    table->masque = 0;
+}
+
+void viderTable(tableTransposition *table)
+{
+    for (uint64_t i = 0; (table->entrees != NULL) && (i <= table->masque); i++)
+    {
+        table->entrees[i].cle = 0;
+        table->entrees[i].profondeur = -1;
+    }
+}
+
+const entreeTable *chercherTable(const tableTransposition *table, uint64_t cle)
+{
+    const entreeTable *entree = &table->entrees[cle & table->masque];
+
+    return ((entree->profondeur >= 0) && (entree->cle == cle)) ? entree : NULL;
+}
+
+void rangerTable(tableTransposition *table, uint64_t cle, int profondeur, int valeur, char coup)
+{
+    entreeTable *entree = &table->entrees[cle & table->masque];
+
+    if ((entree->cle == cle) || (entree->profondeur <= profondeur))
+    {
+        entree->cle = cle;
+        entree->profondeur = profondeur;
+        entree->valeur = valeur;
+        entree->coup = coup;
+    }
+}
+
+/*****************************************************
+ *                 BOITES A OUTILS                   *
+ *****************************************************/
+static size_t arrondir(size_t taille)
+{
+    return (taille + ALIGNEMENT_CLICHE - 1) / ALIGNEMENT_CLICHE * ALIGNEMENT_CLICHE;
+}
+
+static void lierCliche(cliche *photo, const partie *modele, unsigned char *memoire)
+{
+    partie *etat = &photo->etat;
+
+    // dimensions seulement : les tampons et la procédure de dessin restent à zéro
+    etat->largeur = modele->largeur;
+    etat->hauteur = modele->hauteur;
+    etat->largeurLigne = modele->largeurLigne;
+    etat->nbCases = modele->nbCases;
+    etat->leSerpent.tailleMax = modele->leSerpent.tailleMax;
+
+    etat->plateau = (char *)memoire;
+    memoire += arrondir(modele->nbCases);
+    etat->leSerpent.occupation = memoire;
+    memoire += arrondir(modele->nbCases);
+    etat->occupees = (uint64_t *)memoire;
+    memoire += arrondir(MOTS_DECOR(modele->largeur, modele->hauteur) * sizeof(uint64_t));
+    etat->leSerpent.lesX = (int *)memoire;
+    memoire += arrondir(modele->leSerpent.tailleMax * sizeof(int));
+    etat->leSerpent.lesY = (int *)memoire;
+    memoire += arrondir(modele->leSerpent.tailleMax * sizeof(int));
+    etat->lesCasesLibres.cases = memoire;
+    etat->lesCasesLibres.position = NULL;
+    etat->lesCasesLibres.court = INDICES_COURTS(modele->nbCases);
+    memoire += arrondir(modele->nbCases * TAILLE_INDICE(modele->nbCases));
+    etat->coinsPaves = (uint32_t *)memoire;
+}
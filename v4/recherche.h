@@ -0,0 +1,206 @@
+/**
+ * @file recherche.h
+ * @brief Outils pour les agents qui explorent des coups à l'avance : clichés d'une partie
+ *        et table de transposition.
+ *
+ * Un cliché est une copie de l'état complet d'une partie (plateau, serpent, cases
+ * libres, pomme, niveau, vitesse et générateur), de taille fixée par les dimensions
+ * de la partie : le prendre ou le restaurer est une copie de chaque tableau (copierEtat),
+ * réduite à la partie utile (segments du serpent, cases libres, pavés posés). Les
+ * positions des cases libres ne sont pas copiées : restaurer les recalcule par blocs de
+ * cases libres qui diffèrent de celles de la partie. Sur le plateau par défaut (banc
+ * --cliches), prendre un cliché coûte 0,2 à 0,4 µs ; restaurer l'état où la partie est
+ * déjà environ 0,6 µs, mais 2 à 3 µs pour des états pris à plusieurs dizaines de
+ * déplacements les uns des autres, dont presque tous les blocs diffèrent.
+ * Les clichés d'une recherche sont pris dans une réserve allouée une fois, tableaux
+ * compris, sans malloc pendant la recherche.
+ *
+ * La table de transposition retient ce qui a été trouvé pour un état, repéré par sa
+ * clé de Zobrist (jeu->cle) : un état atteint par deux chemins n'est exploré qu'une fois.
+ * Deux chemins ne mènent au même état que si le corps du serpent y est le même : c'est
+ * rare dès que le serpent est plus long que la profondeur explorée, et la table ne fait
+ * alors que coûter. L'exploration de banc s'en passe donc par défaut (--table la met).
+ *
+ * @author Keraudren Johan
+ * @version 4.2
+ * @date 23/11/2024
+ */
+
+#ifndef RECHERCHE_H
+#define RECHERCHE_H
+
+#include <stddef.h>
+#include "libsnake.h"
+
+/** @brief Alignement de chaque tableau d'un cliché */
+#define ALIGNEMENT_CLICHE 64
+
+/** @typedef cliche
+ * @brief Copie de l'état d'une partie, sans sa procédure de dessin, son chronometrage
+ *        ni ses tampons : ses tableaux pointent dans un seul bloc.
+ */
+typedef struct
+{
+    partie etat;
+    void *memoire; // bloc des tableaux, NULL s'il appartient à une réserve
+} cliche;
+
+/** @typedef reserve
+ * @brief Clichés alloués d'avance, pris et rendus comme une pile.
+ */
+typedef struct
+{
+    cliche *cliches;        // capacite clichés
+    unsigned char *memoire; // tableaux des clichés, l'un après l'autre
+    size_t tailleCliche;    // octets des tableaux d'un cliché
+    int capacite;
+    int nombre;             // clichés pris, au début du tableau
+} reserve;
+
+/** @typedef entreeTable
+ * @brief Résultat retenu pour un état.
+ */
+typedef struct
+{
+    uint64_t cle;    // clé de Zobrist de l'état
+    int profondeur;  // profondeur explorée depuis l'état, -1 pour une entrée vide
+    int valeur;      // valeur trouvée par la recherche
+    char coup;       // meilleure touche trouvée
+} entreeTable;
+
+/** @typedef tableTransposition
+ * @brief Table de hachage de taille fixe (puissance de 2), une entrée par case.
+ */
+typedef struct
+{
+    entreeTable *entrees;
+    uint64_t masque;      // nombre d'entrées - 1
+} tableTransposition;
+
+/**
+ * @brief Nombre d'octets des tableaux d'un cliché d'une partie.
+ *
+ * @param modele Partie dont les dimensions sont reprises.
+ * @return Taille, multiple de ALIGNEMENT_CLICHE.
+ */
+size_t tailleCliche(const partie *modele);
+
+/**
+ * @brief Alloue un cliché aux dimensions d'une partie.
+ *
+ * @param photo Cliché à allouer.
+ * @param modele Partie dont les dimensions sont reprises.
+ * @return false si la mémoire manque (le cliché est alors vide).
+ */
+bool creerCliche(cliche *photo, const partie *modele);
+
+/**
+ * @brief Libère la mémoire d'un cliché créé par creerCliche.
+ *
+ * @param photo Cliché à libérer.
+ */
+void detruireCliche(cliche *photo);
+
+/**
+ * @brief Copie l'état d'une partie dans un cliché de mêmes dimensions.
+ *
+ * @param jeu Partie copiée.
+ * @param photo Cliché qui reçoit l'état.
+ */
+void photographier(const partie *jeu, cliche *photo);
+
+/**
+ * @brief Remet une partie dans l'état d'un cliché.
+ *
+ * La procédure de dessin, son contexte et le chronometrage de la partie sont gardés :
+ * l'écran n'est pas redessiné.
+ *
+ * @param jeu Partie restaurée.
+ * @param photo Cliché à restaurer.
+ */
+void restaurer(partie *jeu, const cliche *photo);
+
+/**
+ * @brief Alloue une réserve de clichés aux dimensions d'une partie.
+ *
+ * @param laReserve Réserve à allouer.
+ * @param capacite Nombre maximum de clichés pris en même temps.
+ * @param modele Partie dont les dimensions sont reprises.
+ * @return false si la mémoire manque (la réserve est alors vide).
+ */
+bool creerReserve(reserve *laReserve, int capacite, const partie *modele);
+
+/**
+ * @brief Libère la mémoire d'une réserve.
+ *
+ * @param laReserve Réserve à libérer.
+ */
+void detruireReserve(reserve *laReserve);
+
+/**
+ * @brief Prend un cliché dans la réserve et y copie l'état d'une partie.
+ *
+ * @param laReserve Réserve de clichés.
+ * @param jeu Partie copiée.
+ * @return Cliché pris, NULL si la réserve est pleine.
+ */
+cliche *prendreCliche(reserve *laReserve, const partie *jeu);
+
+/**
+ * @brief Rend les clichés pris après les "nombre" premiers.
+ *
+ * Une recherche note laReserve->nombre avant d'explorer un coup et rend tout ce
+ * qu'elle a pris en revenant.
+ *
+ * @param laReserve Réserve de clichés.
+ * @param nombre Nombre de clichés gardés.
+ */
+void rendreCliches(reserve *laReserve, int nombre);
+
+/**
+ * @brief Alloue une table de transposition vide.
+ *
+ * @param table Table à allouer.
+ * @param bits La table a 2^bits entrées.
+ * @return false si la mémoire manque (la table est alors vide).
+ */
+bool creerTable(tableTransposition *table, int bits);
+
+/**
+ * @brief Libère la mémoire d'une table de transposition.
+ *
+ * @param table Table à libérer.
+ */
+void detruireTable(tableTransposition *table);
+
+/**
+ * @brief Vide toutes les entrées d'une table.
+ *
+ * @param table Table à vider.
+ */
+void viderTable(tableTransposition *table);
+
+/**
+ * @brief Cherche l'entrée d'un état.
+ *
+ * @param table Table de transposition.
+ * @param cle Clé de Zobrist de l'état.
+ * @return Entrée de l'état, NULL s'il n'a pas été rangé (ou a été remplacé).
+ */
+const entreeTable *chercherTable(const tableTransposition *table, uint64_t cle);
+
+/**
+ * @brief Range le résultat de la recherche depuis un état.
+ *
+ * L'entrée déjà présente dans la case est gardée si elle vient d'un autre état
+ * exploré plus profondément.
+ *
+ * @param table Table de transposition.
+ * @param cle Clé de Zobrist de l'état.
+ * @param profondeur Profondeur explorée.
+ * @param valeur Valeur trouvée.
+ * @param coup Meilleure touche trouvée.
+ */
+void rangerTable(tableTransposition *table, uint64_t cle, int profondeur, int valeur, char coup);
+
+#endif
@@ -4,12 +4,21 @@
  *
  * Ce programme implémente un jeu Snake en console, avec des fonctionnalités de déplacement, gestion des collisions,
  * génération de pavés et affichage dynamique.
+ * Les règles du jeu sont dans libsnake.c ; ce fichier gère le terminal, le clavier et la cadence.
+ *
+ * Utilisation : ./snake [--auto] [recueil [numéro du niveau]] ; sans recueil (niveaux.h), la partie
+ * se joue sur le plateau par défaut. Le recueil doit être aux dimensions de l'écran, 80 x 40.
+ * Avec --auto, le serpent est conduit par le pilote automatique (pilote.h). Une touche de direction
+ * l'emporte sur le pilote pour un déplacement, et le pilote répare son chemin depuis la case où elle
+ * a mené la tête ; 'a' arrête toujours le jeu.
  *
  * @author Keraudren Johan
  * @version 4.2
  * @date 23/11/2024
  */
 
+#define _GNU_SOURCE     // ppoll sous Linux
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -18,90 +27,57 @@
 #include <termios.h>
 #include <stdbool.h>
 #include <time.h>
+#include <signal.h>
+#include <poll.h>
+#include "libsnake.h"
+#include "preparation.h"
+#include "niveaux.h"
+#include "pilote.h"
 
-/** @defgroup Constantes Constantes du jeu */
-/**@{*/
-
-/** @brief Largeur minimale de l'aire de jeu */
-#define LARGEUR_MIN 1
-/** @brief Hauteur minimale de l'aire de jeu */
-#define HAUTEUR_MIN 1
-/** @brief Largeur maximale de l'aire de jeu */
-#define LARGEUR_MAX 80
-/** @brief Hauteur maximale de l'aire de jeu */
-#define HAUTEUR_MAX 40
-/** @brief Taille d'un pavé en X*/
-#define TAILLE_PAVES_X 6
-/** @brief Taille d'un pavé en Y*/
-#define TAILLE_PAVES_Y 4
-/** @brief Nombre de pavés */
-#define NOMBRE_PAVES_INIT 1
-/** @brief Nombre max de pavés autorisés */
-#define MAX_PAVES 10000
-/** @brief Caractère pour représenter les bordures */
-#define BORDURE '#'
-/** @brief Caractère pour représenter les pavés*/
-#define PAVES 'P'
-/** @brief Caractère pour représenter le vide */
-#define AIR ' '
-/** @brief Zone de protection horizontale autour du serpent */
-#define ZONE_DE_PROTECTION_X 15
-/** @brief Zone de protection verticale autour du serpent */
-#define ZONE_DE_PROTECTION_Y 5
-
-/** @brief Caractère pour représenter la pomme */
-#define POMME '6'
-/** @brief Nombre de pomme dans le jeu */
-#define NB_POMME 1500
-#define NIVEAU1 3
-
-
-/** @brief Position initiale X du serpent */
-#define X_INITIAL 40
-/** @brief Position initiale Y du serpent */
-#define Y_INITIAL 20
-/** @brief Vitesse initial */
-#define VITESSE_INITIAL 800000
-
-/** @brief Caractère pour représenter la tête du serpent */
-#define TDROITE '>'
-#define TGAUCHE '<'
-#define THAUT '^'
-#define TBAS 'v'
-/** @brief Caractère pour représenter le corps du serpent */
-#define CORPS 'X'
-/** @brief Taille maximum du serpent */
-#define TAILLE_SERPENT_MAX 20
-/** @brief Taille initiale du serpent */
-#define TAILLE_SERPENT_INITIAL 10
-/** @brief Vitesse de déplacement en microsecondes */
-#define ACCELERATION 0.9
-
-/** @brief Touche pour aller en haut */
-#define HAUT 'z'
-/** @brief Touche pour aller en bas */
-#define BAS 's'
-/** @brief Touche pour aller à gauche */
-#define GAUCHE 'q'
-/** @brief Touche pour aller à droite */
-#define DROITE 'd'
 /** @brief Touche pour arrêter le jeu */
 #define STOP 'a'
-
-/** @typedef aireDeJeu
- * @brief Type représentant l'aire de jeu sous forme de tableau 2D.
+/** @brief Nombre maximum de touches en attente entre deux déplacements */
+#define TAILLE_FILE_TOUCHES 64
+
+/** @brief Nombre de cases de l'écran : le plateau par défaut et ses cases de garde */
+#define NB_CASES_ECRAN ((LARGEUR_MAX + 2) * (HAUTEUR_MAX + 2))
+/** @brief Numéro de la case (x, y) dans les tampons de l'écran, ligne par ligne */
+#define CASE_ECRAN(x, y) ((y) * (LARGEUR_MAX + 2) + (x))
+/** @brief Taille du tampon de sortie : une séquence "\033[yyy;xxxf" et un caractère par case */
+#define TAILLE_SORTIE (NB_CASES_ECRAN * 12 + 64)
+
+/** @typedef imageEcran
+ * @brief Contenu de chaque case du terminal, rangé comme le plateau par défaut.
  */
-typedef char aireDeJeu[LARGEUR_MAX + 1][HAUTEUR_MAX + 1];
-
-int pavesX[MAX_PAVES];
-int pavesY[MAX_PAVES];
-
-int pommeX[NB_POMME];
-int pommeY[NB_POMME];
-int nombrePaves = NOMBRE_PAVES_INIT;
-int tailleSerpent = TAILLE_SERPENT_INITIAL;
+typedef char imageEcran[NB_CASES_ECRAN];
+
+imageEcran ecranAffiche; // tampon avant : ce qui est réellement à l'écran
+imageEcran ecranSuivant; // tampon arrière : image en cours de construction
+bool caseModifiee[NB_CASES_ECRAN];
+int modifieesX[NB_CASES_ECRAN]; // liste des cases écrites depuis la dernière image
+int modifieesY[NB_CASES_ECRAN];
+int nbModifiees = 0;
+
+char tamponSortie[TAILLE_SORTIE]; // octets de l'image en cours, envoyés en un seul write
+int tailleSortie = 0;
+long octetsImage = 0;  // octets envoyés pour la dernière image
+long appelsImage = 0;  // appels système write pour la dernière image
+long octetsTotal = 0;
+long appelsTotal = 0;
+long nbImages = 0;
+
+struct termios terminalOrigine; // réglages du terminal à restaurer en fin de partie
+int fluxOrigine;               // drapeaux de l'entrée standard à restaurer
+bool entreeOuverte = false;
+char fileTouches[TAILLE_FILE_TOUCHES]; // touches lues mais pas encore traitées
+int debutFile = 0;
+int nbTouches = 0;
+bool arretLu = false;   // STOP lu, même si la file était pleine
 /**
- * @brief Affiche un caractère à une position donnée dans la console.
+ * @brief Écrit un caractère à une position donnée dans le tampon arrière.
+ *
+ * Rien n'est envoyé au terminal : la case est seulement notée comme modifiée
+ * et sera émise par rendreImage() si elle diffère de l'écran.
  *
  * @param x Coordonnée X.
  * @param y Coordonnée Y.
@@ -109,6 +85,37 @@ int tailleSerpent = TAILLE_SERPENT_INITIAL;
  */
 void afficher(int x, int y, char c);
 
+/**
+ * @brief Initialise les tampons avant et arrière avec un écran vide.
+ */
+void initEcran();
+
+/**
+ * @brief Envoie au terminal uniquement les cases qui diffèrent de l'écran.
+ */
+void rendreImage();
+
+/**
+ * @brief Ajoute un caractère au tampon de sortie.
+ *
+ * @param c Caractère à ajouter.
+ */
+void sortieCaractere(char c);
+
+/**
+ * @brief Ajoute l'écriture décimale d'un entier positif au tampon de sortie.
+ *
+ * @param n Entier à écrire.
+ */
+void sortieEntier(int n);
+
+/**
+ * @brief Envoie le tampon de sortie au terminal avec un seul appel à write.
+ *
+ * Met à jour les compteurs d'octets et d'appels système de l'image.
+ */
+void viderSortie();
+
 /**
  * @brief Efface un caractère à une position donnée dans la console.
  *
@@ -118,165 +125,248 @@ void afficher(int x, int y, char c);
 void effacer(int x, int y);
 
 /**
- * @brief Initialise l'aire de jeu avec des bordures et de l'air.
+ * @brief Procédure de dessin de la partie : écrit la case dans le tampon arrière.
  *
- * @param tableau Tableau représentant l'aire de jeu.
+ * @param contexte Inutilisé, l'écran est unique.
+ * @param x Coordonnée X.
+ * @param y Coordonnée Y.
+ * @param c Caractère à afficher.
  */
-void initPlateau(aireDeJeu tableau,int nombrePaves);
+void dessinerTerminal(void *contexte, int x, int y, char c);
 
 /**
- * @brief Place un pavé dans l'aire de jeu en évitant la zone de protection.
+ * @brief Affiche la pomme courante.
  *
- * @param tableau Tableau représentant l'aire de jeu.
+ * @param jeu Partie en cours.
  */
-void initPaves(aireDeJeu tableau,int nombrePaves);
+void afficherPomme(const partie *jeu);
+
 /**
- * @brief  Place des pommes aléatoirement sur le plateau sans être sur le serpent si sur un pavés
- *
+ * @brief Affiche l'aire de jeu complète dans la console (premier affichage uniquement).
  *
+ * @param jeu Partie dont le plateau est affiché.
  */
-void ajouterPomme(int lesX[], int LesY[], int numeroPomme);
+void affichagePlateau(const partie *jeu);
 
-void afficherPomme(int numeroPomme);
-
-void setLevel(int numeroPomme,int lesX[],int lesY[],float *vitesseSerpent,aireDeJeu plateau);
+/**
+ * @brief Dessine le serpent en entier dans le tampon arrière.
+ *
+ * @param leSerpent Corps du serpent.
+ * @param tete Caractère de la tête.
+ */
+void dessinerSerpent(const serpent *leSerpent, char tete);
 
-bool teteTouchePomme(int lesX[], int lesY[], int pommeX[], int pommeY[], int indice);
 /**
- * @brief Place un pavé dans l'aire de jeu en évitant la zone de protection.
+ * @brief Affiche un message de fin de jeu et restaure les paramètres de la console.
  *
- * @param tableau Tableau représentant l'aire de jeu.
+ * @param numeroPomme Score du joueur.
+ * @param plein Indique si la partie s'est arrêtée faute de case libre pour la pomme.
  */
-bool estPositionUnique(int x, int y, int *tempX, int *tempY, int taille);
+void finDuJeu(int numeroPomme, bool plein);
 
 /**
- * @brief Affiche l'aire de jeu dans la console.
+ * @brief Positionne le curseur de la console à une coordonnée donnée.
  *
- * @param tableau Tableau représentant l'aire de jeu.
+ * @param x Coordonnée X.
+ * @param y Coordonnée Y.
  */
-void affichagePlateau(aireDeJeu tableau);
+void gotoXY(int x, int y);
 
 /**
- * @brief Détermine la nouvelle direction du serpent en fonction de la touche appuyée.
+ * @brief Passe le terminal en mode non canonique, sans écho et non bloquant pour toute la partie.
  *
- * @param touche Touche saisie par l'utilisateur.
- * @param direction Direction actuelle.
- * @return Nouvelle direction.
+ * Le mode d'origine est restauré par fermerEntree(), appelée à la sortie du programme
+ * et à la réception d'un signal d'arrêt.
+ */
+void ouvrirEntree();
+
+/**
+ * @brief Restaure les réglages d'origine du terminal.
  */
-char definirDirection(char touche, char direction);
+void fermerEntree();
 
 /**
- * @brief Determine l'endroit de la tête puis lui permet de changer de coté
+ * @brief Restaure le terminal puis termine le programme avec le signal reçu.
  *
- * @param lesX Tableau des coordonnées X des segments du serpent.
- * @param lesY Tableau des coordonnées Y des segments du serpent.
+ * @param numero Numéro du signal reçu.
  */
-void teleportation(int lesX[], int lesY[]);
+void interrompre(int numero);
 
 /**
- * @brief Dessine le serpent dans la console.
+ * @brief Lit toutes les touches disponibles avec un seul appel à read et les ajoute à la file.
  *
- * @param lesX Tableau des coordonnées X des segments du serpent.
- * @param lesY Tableau des coordonnées Y des segments du serpent.
+ * Les touches qui ne tiennent plus dans la file sont perdues, sauf STOP qui est retenu à part.
+ *
+ * @return Nombre de touches lues, 0 si aucune (read interrompu), -1 si l'entrée est fermée.
  */
-void dessinerSerpent(int lesX[], int lesY[], int tailleSerpent,char tete);
+int lireEntree();
 
 /**
- * @brief Déplace le serpent d'une case dans la direction donnée.
+ * @brief Retire la plus ancienne touche de la file.
  *
- * @param lesX Tableau des coordonnées X des segments du serpent.
- * @param lesY Tableau des coordonnées Y des segments du serpent.
- * @param direction Direction du mouvement ('z', 's', 'q', 'd').
- * @param statut Indique si une collision a été détectée.
+ * @param touche Touche retirée.
+ * @return true si une touche était en attente, false sinon.
  */
-void progresser(int lesX[], int lesY[], char direction, bool *statut, bool *pomme);
+bool toucheSuivante(char *touche);
 
 /**
- * @brief Affiche un message de fin de jeu et restaure les paramètres de la console.
+ * @brief Applique les touches en attente : au plus un changement de direction par déplacement.
+ *
+ * @param touche Dernière touche lue.
+ * @param direction Direction du dernier déplacement.
+ * @param prochaineDirection Direction retenue pour le prochain déplacement.
  */
-void finDuJeu(int numeroPomme);
+void traiterTouches(char *touche, char direction, char *prochaineDirection);
 
 /**
- * @brief Positionne le curseur de la console à une coordonnée donnée.
+ * @brief Attend l'échéance du prochain déplacement en traitant les touches dès leur arrivée.
  *
- * @param x Coordonnée X.
- * @param y Coordonnée Y.
+ * L'attente se fait sur l'entrée standard jusqu'à l'échéance absolue : le temps passé
+ * à calculer et afficher l'image ne décale pas la cadence. Sous Linux, ppoll attend à
+ * la nanoseconde ; ailleurs (macOS), poll attend en millisecondes arrondies au-dessus.
+ *
+ * @param echeance Instant (CLOCK_MONOTONIC) du prochain déplacement.
+ * @param touche Dernière touche lue.
+ * @param direction Direction du dernier déplacement.
+ * @param prochaineDirection Direction retenue pour le prochain déplacement.
  */
-void gotoXY(int x, int y);
+void attendreDeplacement(struct timespec *echeance, char *touche, char direction, char *prochaineDirection);
 
 /**
- * @brief Vérifie si une touche a été pressée sans attendre.
+ * @brief Avance une échéance d'une durée donnée.
  *
- * @return 1 si une touche a été pressée, 0 sinon.
+ * @param echeance Instant à avancer.
+ * @param microsecondes Durée à ajouter.
  */
-int kbhit(void);
+void avancerEcheance(struct timespec *echeance, long microsecondes);
 
 /**
- * @brief Désactive l'affichage des caractères tapés dans la console.
+ * @brief Calcule le temps restant avant une échéance.
+ *
+ * @param echeance Instant visé (CLOCK_MONOTONIC).
+ * @return Nanosecondes restantes, négatif si l'échéance est dépassée.
  */
-void disableEcho();
+long long nanosecondesRestantes(const struct timespec *echeance);
 
 /**
- * @brief Réactive l'affichage des caractères tapés dans la console.
+ * @brief Dort jusqu'à une échéance, sans lire l'entrée.
+ *
+ * @param echeance Instant visé (CLOCK_MONOTONIC).
  */
-void enableEcho();
+void dormirJusqua(const struct timespec *echeance);
 
 /*****************************************************
  *                 PROGRAMME PRINCIPALE              *
  *****************************************************/
-int main()
+int main(int argc, char *argv[])
 {
     // Initialisation des variables .
-    srand(time(NULL));
-    aireDeJeu plateau;
-    int x, y;
-    float vitesseSerpent = VITESSE_INITIAL;                 //
-    int lesX[TAILLE_SERPENT_MAX], lesY[TAILLE_SERPENT_MAX]; // création des tableaux des coordonnées
+    partie jeu;                                             // état complet de la partie
+    parametres config;                                      // réglages de la partie
+    preparation prepa;                                      // fil qui tire d'avance les pavés du niveau suivant
+    bool prepare;
     char touche = DROITE;                                   // Variable pour stocker la touche appuyée && mise a DROITE pour que le serpent va vers la droite
-    char direction = DROITE;                                // Variable pour définir la direction
-    bool pomme = false;
-    int numeroPomme = 0;
+    char prochaineDirection = DROITE;                       // Direction demandée pour le prochain déplacement
+    struct timespec echeance;                               // Instant du prochain déplacement
+    int evenements = 0;                                     // événements du dernier déplacement
+    recueil niveaux;                                        // recueil donné en argument, vide sans
+    int numeroNiveau;
+    pilote lePilote;                                        // conduit le serpent avec --auto
+    bool automatique = (argc > 1) && (strcmp(argv[1], "--auto") == 0);
+
+    // --auto retiré, les arguments restants sont le recueil et le numéro du niveau
+    if (automatique)
+    {
+        argc--;
+        argv++;
+    }
+    numeroNiveau = (argc > 2) ? atoi(argv[2]) : 0;
+    // le terminal affiche le plateau par défaut, aux dimensions des tampons de l'écran
+    parametresParDefaut(&config);
+    memset(&niveaux, 0, sizeof(niveaux));
+    if ((argc > 1) && (!ouvrirRecueil(&niveaux, argv[1]) || (niveaux.largeur != LARGEUR_MAX)
+                    || (niveaux.hauteur != HAUTEUR_MAX) || (numeroNiveau < 0) || (numeroNiveau >= niveaux.nombre)))
+    {
+        fprintf(stderr, "%s : pas de niveau %d de %d x %d\n", argv[1], numeroNiveau, LARGEUR_MAX, HAUTEUR_MAX);
+        fermerRecueil(&niveaux);
+        return EXIT_FAILURE;
+    }
+    if (argc > 1)
+    {
+        config.decor = decorRecueil(&niveaux, numeroNiveau);
+    }
     system("clear");
-    disableEcho();
-    bool statut = false;
+    ouvrirEntree();
 
-    // Incrémentation des coordonnées.
-    x = X_INITIAL;
-    y = Y_INITIAL;
-
-    for (int i = 0; i < TAILLE_SERPENT_INITIAL; i++)
+    initEcran();
+    config.dessiner = dessinerTerminal;
+    if (!creerPartie(&jeu, &config))
     {
-        lesX[i] = x--;
-        lesY[i] = y;
+        fermerEntree();
+        fermerRecueil(&niveaux);
+        fprintf(stderr, "mémoire insuffisante\n");
+        return EXIT_FAILURE;
     }
-
-    affichagePlateau(plateau);
-    ajouterPomme(lesX, lesY, numeroPomme);
+    if (automatique && !creerPilote(&lePilote, &jeu))
+    {
+        fermerEntree();
+        detruirePartie(&jeu);
+        fermerRecueil(&niveaux);
+        fprintf(stderr, "mémoire insuffisante\n");
+        return EXIT_FAILURE;
+    }
+    // sans fil de préparation, les pavés sont tirés au passage de niveau : même partie, un peu d'attente
+    prepare = creerPreparation(&prepa, &jeu);
+    if (prepare)
+    {
+        config.commander = commanderPavage;
+        config.livrer = livrerPavage;
+        config.atelier = &prepa;
+    }
+    if (!initPartie(&jeu, time(NULL), &config))
+    {
+        evenements = EVENEMENT_PLEIN;
+    }
+    affichagePlateau(&jeu);
+    afficherPomme(&jeu);
+    dessinerSerpent(&jeu.leSerpent, TDROITE);
+    rendreImage();
+    clock_gettime(CLOCK_MONOTONIC, &echeance);
     // déplacement du serpent tant que la touche 'a' n'a pas été enfoncer.
-    do
+    while ((touche != STOP) && ((evenements & EVENEMENT_FIN) == 0))
     {
-
-        if (kbhit())
+        // une touche du joueur qui change la direction l'emporte sur le pilote pour ce déplacement
+        if (automatique && (prochaineDirection == jeu.direction))
         {
-            touche = getchar(); // Lire la touche pressée
+            prochaineDirection = planifier(&lePilote, &jeu);
         }
-
-        if (pomme == true)
+        evenements = avancer(&jeu, prochaineDirection);
+        rendreImage();
+        if (automatique)
         {
-
-            numeroPomme++;
-            setLevel(numeroPomme,lesX,lesY,&vitesseSerpent,plateau);
-            
-            pomme = false;
+            // le pilote choisit de nouveau, sauf si une touche est retenue pendant l'attente
+            prochaineDirection = jeu.direction;
         }
 
-        direction = definirDirection(touche, direction);
-        progresser(lesX, lesY, direction, &statut, &pomme);
-        usleep(vitesseSerpent);
-
-    } while ((touche != STOP) && (statut != true) && (numeroPomme < NB_POMME));
+        // les échéances sont absolues : pas de dérive due au temps de calcul
+        if ((evenements & EVENEMENT_FIN) == 0)
+        {
+            avancerEcheance(&echeance, jeu.vitesseSerpent);
+            attendreDeplacement(&echeance, &touche, jeu.direction, &prochaineDirection);
+        }
+    }
 
-    finDuJeu(numeroPomme);
+    finDuJeu(jeu.numeroPomme, (evenements & EVENEMENT_PLEIN) != 0);
+    if (prepare)
+    {
+        detruirePreparation(&prepa);
+    }
+    if (automatique)
+    {
+        detruirePilote(&lePilote);
+    }
+    detruirePartie(&jeu);
+    fermerRecueil(&niveaux);
     return EXIT_SUCCESS;
 }
 /*****************************************************
@@ -285,465 +375,370 @@ int main()
 
 void afficher(int x, int y, char c)
 {
-    /* @brief Faire l'affichage */
+    /* @brief Faire l'affichage dans le tampon arrière */
     if (((y >= HAUTEUR_MIN) 
-    && (y <= HAUTEUR_MAX + 1)) 
+    && (y <= HAUTEUR_MAX)) 
     && ((x >= LARGEUR_MIN) 
-    && (x <= LARGEUR_MAX + 1))) // check pour savoir si la valeur a écrire se situe dans l'espace de jeu
+    && (x <= LARGEUR_MAX))) // check pour savoir si la valeur a écrire se situe dans l'espace de jeu
     {
-        gotoXY(x, y);
-        printf("%c", c);
+        ecranSuivant[CASE_ECRAN(x, y)] = c;
+        if (!caseModifiee[CASE_ECRAN(x, y)])
+        {
+            caseModifiee[CASE_ECRAN(x, y)] = true;
+            modifieesX[nbModifiees] = x;
+            modifieesY[nbModifiees] = y;
+            nbModifiees++;
+        }
     }
 }
 
-void effacer(int x, int y)
+void initEcran()
 {
-    /* @brief On efface la position donner. */
-
-    afficher(x, y, ' ');
+    // l'écran vient d'être effacé par "clear" : les deux tampons sont vides
+    memset(ecranAffiche, AIR, sizeof(imageEcran));
+    memset(ecranSuivant, AIR, sizeof(imageEcran));
+    memset(caseModifiee, false, sizeof(caseModifiee));
+    nbModifiees = 0;
 }
-void initPlateau(aireDeJeu plateau,int nombrePaves)
-{
 
-    for (int lig = 0; lig <= LARGEUR_MAX; lig++)
-    {
-        for (int col = 0; col <= HAUTEUR_MAX; col++)
+void rendreImage()
+{
+    int x, y, numeroCase;
+    for (int i = 0; i < nbModifiees; i++)
+    {
+        x = modifieesX[i];
+        y = modifieesY[i];
+        numeroCase = CASE_ECRAN(x, y);
+        caseModifiee[numeroCase] = false;
+        // une case réécrite avec le même caractère n'est pas renvoyée
+        if (ecranSuivant[numeroCase] != ecranAffiche[numeroCase])
         {
-            if (((lig == LARGEUR_MIN) 
-            || (lig == LARGEUR_MAX)) 
-            || ((col == HAUTEUR_MIN) 
-            || (col == HAUTEUR_MAX)))
-            {
-                plateau[lig][col] = BORDURE;
-            }
-            else
-            {
-                plateau[lig][col] = AIR;
-            }
+            gotoXY(x, y);
+            sortieCaractere(ecranSuivant[numeroCase]);
+            ecranAffiche[numeroCase] = ecranSuivant[numeroCase];
         }
     }
-    plateau[LARGEUR_MAX / 2][HAUTEUR_MIN] = AIR; // téléporteur du haut
-    plateau[LARGEUR_MAX / 2][HAUTEUR_MAX] = AIR; // téléporteur du bas
-    plateau[LARGEUR_MAX][HAUTEUR_MAX / 2] = AIR;
-    plateau[LARGEUR_MIN][HAUTEUR_MAX / 2] = AIR;
-    // ajout des pavés
-    initPaves(plateau,nombrePaves);
+    nbModifiees = 0;
+    viderSortie();
 }
 
-void initPaves(aireDeJeu plateau,int nombrePaves)
+void sortieCaractere(char c)
 {
-    int x, y;
-    int coordX[MAX_PAVES];
-    int coordY[MAX_PAVES];
-    int compteurPaves = 0;
-    bool valide = false;
-    for (int i = 0; i < nombrePaves; i++)
-    {
-        do
-        {
-            // Génération aléatoire de la position du pavé
-            x = rand() % (LARGEUR_MAX - TAILLE_PAVES_X - 3) + 3;
-            y = rand() % (HAUTEUR_MAX - TAILLE_PAVES_Y - 3) + 3;
-            coordX[compteurPaves] = x;
-            coordY[compteurPaves] = y;
-            compteurPaves++;
-
-            valide = estPositionUnique(x, y, coordX, coordY, compteurPaves);
-
-        } while ((x >= X_INITIAL - ZONE_DE_PROTECTION_X 
-        && x <= X_INITIAL + ZONE_DE_PROTECTION_X 
-        && y >= Y_INITIAL - ZONE_DE_PROTECTION_Y 
-        && y <= Y_INITIAL + ZONE_DE_PROTECTION_Y) 
-        || (valide != true));
-
-        // Vérification de la zone de protection = la position initiale du serpent (rectangle autour du serpent(pour verifier => #define NOMBRE_PAVES 10000)).
-
-        // AJOUT DANS LE TABLEAU
-        for (int dx = 0; dx < TAILLE_PAVES_X; dx++)
-        {
-            for (int dy = 0; dy < TAILLE_PAVES_Y; dy++)
-            {
-                plateau[dx + x][dy + y] = PAVES;
-                pavesX[i * TAILLE_PAVES_X + dx] = x + dx; // on traite les pavés avec I ,puis la taille d'un pavé X les coordonnées X
-                pavesY[i * TAILLE_PAVES_Y + dy] = y + dy; // même chose mais avec Y
-            }
-        }
+    if (tailleSortie < TAILLE_SORTIE)
+    {
+        tamponSortie[tailleSortie] = c;
+        tailleSortie++;
     }
 }
-void ajouterPomme(int lesX[], int lesY[], int numeroPomme)
+
+void sortieEntier(int n)
 {
-    int x, y;
-    int compteurPomme = 10;
-    bool positionValide = true;
-    int tailleSerpent = 10;
+    char chiffres[12];
+    int nbChiffres = 0;
+
+    // les chiffres sont obtenus à l'envers puis recopiés dans l'ordre
     do
     {
-        // Génération aléatoire de la position du pavé
-        x = rand() % (LARGEUR_MAX - 3) + 2; // Coordonnées dans les limites
-        y = rand() % (HAUTEUR_MAX - 3) + 2;
-        pommeX[numeroPomme] = x;
-        pommeY[numeroPomme] = y;
-
-        positionValide = estPositionUnique(x, y, pommeX, pommeY, compteurPomme);
+        chiffres[nbChiffres] = '0' + n % 10;
+        nbChiffres++;
+        n = n / 10;
+    } while (n > 0);
 
-        // Vérifier que la pommene tombe pas sur le serpent
-        for (int i = 0; i < tailleSerpent; i++)
-        {
-            if (lesX[i] == x && lesY[i] == y)
-            {
-                positionValide = false;
-            }
-        }
-
-        // Vérifier que la pomme ne tombe pas sur un pavé
-        for (int i = 0; i < nombrePaves; i++)
-        {
-            for (int dx = 0; dx < TAILLE_PAVES_X; dx++)
-            {
-                for (int dy = 0; dy < TAILLE_PAVES_Y; dy++)
-                {
-                    if (x == pavesX[i * TAILLE_PAVES_X + dx] &&
-                        y == pavesY[i * TAILLE_PAVES_Y + dy])
-                    {
-                        positionValide = false;
-                    }
-                }
-            }
-        }
-    } while (positionValide != true);
-
-    if (numeroPomme >= NB_POMME)
+    while (nbChiffres > 0)
     {
-        numeroPomme = 0; // Réinitialise le compteur si on dépasse le nombre maximum de pommes
+        nbChiffres--;
+        sortieCaractere(chiffres[nbChiffres]);
     }
-    tailleSerpent++;
-    afficherPomme(numeroPomme);
 }
 
-void afficherPomme(int numeroPomme)
+void viderSortie()
 {
-    // Effacer toutes les anciennes pommes
-    for (int i = 0; i < NB_POMME; i++)
+    int envoyes = 0;
+    ssize_t resultat;
+
+    octetsImage = tailleSortie;
+    appelsImage = 0;
+    // un seul write suffit, la boucle ne sert que si le terminal accepte moins d'octets
+    while (envoyes < tailleSortie)
     {
-        if (i != numeroPomme) // Ne pas effacer la pomme actuelle
+        resultat = write(STDOUT_FILENO, tamponSortie + envoyes, tailleSortie - envoyes);
+        appelsImage++;
+        if (resultat <= 0)
         {
-            afficher(pommeX[i], pommeY[i], AIR);
+            break;
         }
+        envoyes += resultat;
     }
-    // Afficher uniquement la pomme courante
-    afficher(pommeX[numeroPomme], pommeY[numeroPomme], POMME);
+    tailleSortie = 0;
+
+    octetsTotal += octetsImage;
+    appelsTotal += appelsImage;
+    nbImages++;
 }
-void setLevel(int numeroPomme,int lesX[],int lesY[],float *vitesseSerpent,aireDeJeu plateau){
-    static int level = NIVEAU1;
-    if(numeroPomme == level){
-        nombrePaves = nombrePaves * 2;
-        tailleSerpent++;
-        *vitesseSerpent = *vitesseSerpent * ACCELERATION;
-        affichagePlateau(plateau);
-        level = level * 2;
-        
 
-    }
-    ajouterPomme(lesX, lesY, numeroPomme);
-    
+void effacer(int x, int y)
+{
+    /* @brief On efface la position donner. */
 
+    afficher(x, y, ' ');
 }
 
-bool teteTouchePomme(int lesX[], int lesY[], int pommeX[], int pommeY[], int indice)
+void dessinerTerminal(void *contexte, int x, int y, char c)
 {
-    bool pommeToucher = false;
-    // Vérifier la collision avec la pomme actuelle uniquement
-    if ((lesX[0] == pommeX[indice]) && (lesY[0] == pommeY[indice]))
-    {
-        pommeToucher = true;
-    }
-    return pommeToucher;
+    (void)contexte;
+    afficher(x, y, c);
 }
 
-/** @brief Fonction pour vérifier si une paire (x, y) existe déjà */
-bool estPositionUnique(int x, int y, int *tempX, int *tempY, int taille)
+void afficherPomme(const partie *jeu)
 {
-    bool statut;
-    for (int i = 0; i < taille; i++)
-    {
-        if (tempX[i] == x && tempY[i] == y)
-        {
-            statut = false; // La position est déjà utilisée
-        }
-    }
-    statut = true; // La position est unique
-    return statut;
+    // L'ancienne pomme a déjà été effacée par la tête du serpent dans progresser,
+    // il suffit d'afficher la pomme courante
+    afficher(jeu->pommeX, jeu->pommeY, POMME);
 }
-
-void affichagePlateau(aireDeJeu plateau)
+void affichagePlateau(const partie *jeu)
 {
-    initPlateau(plateau,nombrePaves);
-    for (int lig = 1; lig <= LARGEUR_MAX; lig++)
+    // ligne par ligne, dans l'ordre du plateau en mémoire et de l'écran
+    for (int col = 1; col <= jeu->hauteur; col++)
     {
-        for (int col = 1; col <= HAUTEUR_MAX; col++)
+        for (int lig = 1; lig <= jeu->largeur; lig++)
         {
-            afficher(lig, col, plateau[lig][col]);
+            afficher(lig, col, jeu->plateau[NUMERO_CASE(jeu, lig, col)]);
         }
     }
 }
 
-char definirDirection(char touche, char direction)
+void dessinerSerpent(const serpent *leSerpent, char tete)
 {
-    /**@brief Fonction permettant de modifier la direction de déplacement du serpent .*/
+    /** @brief On dessine le serpent */
+    int segment;
 
-    if (touche == HAUT && direction != BAS) // Récupération de la nouvelle valeur et de l'ancienne
-    {
-        direction = HAUT; // assignation
-    }
-    else if ((touche == BAS) && (direction != HAUT)) // Récupération de la nouvelle valeur et de l'ancienne
-    {
-        direction = BAS; // assignation
-    }
-    else if ((touche == GAUCHE) && (direction != DROITE)) // Récupération de la nouvelle valeur et de l'ancienne
+    afficher(leSerpent->lesX[leSerpent->tete], leSerpent->lesY[leSerpent->tete], tete);
+    for (int i = 1; i < leSerpent->taille; i++)
     {
-        direction = GAUCHE; // assignation
+        segment = indiceSegment(leSerpent, i);
+        afficher(leSerpent->lesX[segment], leSerpent->lesY[segment], CORPS);
     }
-    else if ((touche == DROITE) && (direction != GAUCHE)) // Récupération de la nouvelle valeur et de l'ancienne
-    {
-        direction = DROITE; // assignation
-    }
-    return direction;
 }
-void teleportation(int lesX[], int lesY[])
+void finDuJeu(int numeroPomme, bool plein)
 {
-    if ((lesX[0] == LARGEUR_MAX / 2) && (lesY[0] == HAUTEUR_MIN))
+    /* @brief Fin du programme , message de fin et réactivation de l'écriture dans la console*/
+    fermerEntree();
+    gotoXY(1, 50);
+    viderSortie();
+
+    printf("La partie est terminée !\n");
+    if (plein)
     {
-        // haut
-        lesX[0] = LARGEUR_MAX / 2;
-        lesY[0] = HAUTEUR_MAX;
+        printf("Plus aucune case libre pour la pomme : le plateau est plein.\n");
     }
-    else if ((lesX[0] == LARGEUR_MAX / 2) && (lesY[0] == HAUTEUR_MAX))
+    printf("Votre score est de ; %d\n", numeroPomme);
+    if (nbImages > 0)
     {
-        // bas
-        lesX[0] = LARGEUR_MAX / 2;
-        lesY[0] = HAUTEUR_MIN;
+        printf("Images : %ld, %ld octets et %ld appels write au total (%.1f octets par image)\n",
+               nbImages, octetsTotal, appelsTotal, (double)octetsTotal / nbImages);
     }
-    else if ((lesX[0] == LARGEUR_MIN) && (lesY[0] == HAUTEUR_MAX / 2))
+}
+/*****************************************************
+ *                 BOITES A OUTILS                   *
+ *****************************************************/
+void gotoXY(int x, int y)
+{
+    // équivalent de printf("\033[%d;%df", y, x) dans le tampon de sortie
+    sortieCaractere('\033');
+    sortieCaractere('[');
+    sortieEntier(y);
+    sortieCaractere(';');
+    sortieEntier(x);
+    sortieCaractere('f');
+}
+
+void ouvrirEntree()
+{
+    struct termios tty;
+    struct sigaction action;
+
+    // Obtenir les attributs du terminal
+    if (tcgetattr(STDIN_FILENO, &terminalOrigine) == -1)
     {
-        // gauche
-        lesX[0] = LARGEUR_MAX - 1;
-        lesY[0] = HAUTEUR_MAX / 2;
+        perror("tcgetattr");
+        exit(EXIT_FAILURE);
     }
-    else if ((lesX[0] == LARGEUR_MAX) && (lesY[0] == HAUTEUR_MAX / 2))
+    fluxOrigine = fcntl(STDIN_FILENO, F_GETFL, 0);
+
+    // Mode non canonique sans écho : read rend immédiatement ce qui est disponible
+    tty = terminalOrigine;
+    tty.c_lflag &= ~(ICANON | ECHO);
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSANOW, &tty) == -1)
     {
-        // droite
-        lesX[0] = LARGEUR_MIN;
-        lesY[0] = HAUTEUR_MAX / 2;
+        perror("tcsetattr");
+        exit(EXIT_FAILURE);
     }
+    fcntl(STDIN_FILENO, F_SETFL, fluxOrigine | O_NONBLOCK);
+    entreeOuverte = true;
+
+    // Restauration du terminal en fin de programme, même interrompu
+    atexit(fermerEntree);
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = interrompre;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    sigaction(SIGHUP, &action, NULL);
+    sigaction(SIGQUIT, &action, NULL);
 }
 
-void dessinerSerpent(int lesX[], int lesY[], int tailleSerpent, char tete)
+void fermerEntree()
 {
-    /** @brief On dessine le serpent */
-
-    afficher(lesX[0], lesY[0], tete);
-    for (int i = 1; i < tailleSerpent; i++)
+    if (entreeOuverte)
     {
-        afficher(lesX[i], lesY[i], CORPS);
+        tcsetattr(STDIN_FILENO, TCSANOW, &terminalOrigine);
+        fcntl(STDIN_FILENO, F_SETFL, fluxOrigine);
+        entreeOuverte = false;
     }
-    fflush(stdout);
 }
-void progresser(int lesX[], int lesY[], char direction, bool *statut, bool *pomme)
-{
-    static int indice = 0;
-    char tete = TDROITE;
-    /*!
-     * Explication :
-     * mise en place d'un static pour eviter de futur soucis lors des
-     * modifications de ces variables pour de futurs ajoutent.
-     * (static mets en mémoire une seule fois dans le programme tandis que sinon
-     * elle est mise automatiquement lors de l'appel de fonction.
-     * Dans ce programme,si ce n'est pas du static, elle remet à 0 lors de l'appel de la fonction progresser
-     * et donc crée des problèmes lors de leurs envoie dans d'autres procédure
-     * ou en interne.)
-     */
-
-    if (!*pomme)
-    {
-        effacer(lesX[tailleSerpent - 1], lesY[tailleSerpent - 1]);
-    }
 
-    for (int i = tailleSerpent - 1; i > 0; i--)
-    {
-        lesX[i] = lesX[i - 1];
-        lesY[i] = lesY[i - 1];
-    }
+void interrompre(int numero)
+{
+    // tcsetattr et fcntl peuvent être appelés depuis un gestionnaire de signal
+    fermerEntree();
+    signal(numero, SIG_DFL);
+    raise(numero);
+}
 
-    // Mise à jour de la position de la tête
-    switch (direction)
-    {
-    case DROITE:
-        lesX[0]++;
-        tete = TDROITE;
-        break;
-    case GAUCHE:
-        lesX[0]--;
-        tete = TGAUCHE;
-        break;
-    case BAS:
-        lesY[0]++;
-        tete = TBAS;
-        break;
-    default:
-        lesY[0]--;
-        tete = THAUT;
-        break;
-    }
+int lireEntree()
+{
+    char lues[TAILLE_FILE_TOUCHES];
+    ssize_t nbLues = read(STDIN_FILENO, lues, sizeof(lues));
+    int resultat = (nbLues == 0) ? -1 : 0;
 
-    // Gestion des collisions avec les bordures et téléportation
-    if (((lesX[0] == LARGEUR_MIN) || (lesX[0] == LARGEUR_MAX)) ||
-        ((lesY[0] == HAUTEUR_MIN) || (lesY[0] == HAUTEUR_MAX)))
+    for (int i = 0; i < nbLues; i++)
     {
-        if (((lesX[0] == LARGEUR_MAX / 2) && (lesY[0] == HAUTEUR_MIN)) ||
-            ((lesX[0] == LARGEUR_MAX / 2) && (lesY[0] == HAUTEUR_MAX)) ||
-            ((lesX[0] == LARGEUR_MIN) && (lesY[0] == HAUTEUR_MAX / 2)) ||
-            ((lesX[0] == LARGEUR_MAX) && (lesY[0] == HAUTEUR_MAX / 2)))
+        if (lues[i] == STOP)
         {
-            *statut = false;
-            teleportation(lesX, lesY);
+            arretLu = true;
         }
-        else
+        if (nbTouches < TAILLE_FILE_TOUCHES)
         {
-            *statut = true;
+            fileTouches[(debutFile + nbTouches) % TAILLE_FILE_TOUCHES] = lues[i];
+            nbTouches++;
         }
     }
-
-    // Collision avec le serpent
-    for (int i = 1; i < tailleSerpent; i++)
+    if (nbLues > 0)
     {
-        if ((lesX[0] == lesX[i]) && (lesY[0] == lesY[i]))
-        {
-            *statut = true;
-        }
+        resultat = nbLues;
     }
-
-    // Collision avec les pavés
-    for (int i = 0; i < nombrePaves; i++)
-    {
-        for (int dx = 0; dx < TAILLE_PAVES_X; dx++)
-        {
-            for (int dy = 0; dy < TAILLE_PAVES_Y; dy++)
-            {
-                if ((lesX[0] == pavesX[i * TAILLE_PAVES_X + dx]) &&
-                    (lesY[0] == pavesY[i * TAILLE_PAVES_Y + dy]))
-                {
-                    *statut = true;
-                }
-            }
-        }
-    }
-
-    // Gestion des pommes
-    *pomme = teteTouchePomme(lesX, lesY, pommeX, pommeY, indice);
-    if (*pomme)
-    {
-        // Effacer la pomme mangée sur le plateau
-        afficher(pommeX[indice], pommeY[indice], AIR);
-
-        indice++;
-        if (indice >= NB_POMME)
-        {
-            indice = 0;
-        }
-    }
-
-    dessinerSerpent(lesX, lesY, tailleSerpent,tete);
+    return resultat;
 }
 
-void finDuJeu(int numeroPomme)
+bool toucheSuivante(char *touche)
 {
-    /* @brief Fin du programme , message de fin et réactivation de l'écriture dans la console*/
-    enableEcho();
-    gotoXY(1, 50);
-
-    printf("La partie est terminée !\n");
-    printf("Votre score est de ; %d", numeroPomme);
-}
-/*****************************************************
- *                 BOITES A OUTILS                   *
- *****************************************************/
-void gotoXY(int x, int y)
-{
-    printf("\033[%d;%df", y, x);
+    bool disponible = false;
+    if (nbTouches > 0)
+    {
+        *touche = fileTouches[debutFile];
+        debutFile = (debutFile + 1) % TAILLE_FILE_TOUCHES;
+        nbTouches--;
+        disponible = true;
+    }
+    return disponible;
 }
 
-int kbhit()
+void traiterTouches(char *touche, char direction, char *prochaineDirection)
 {
-    // la fonction retourne :
-    // 1 si un caractere est present
-    // 0 si pas de caractere present
-
-    int unCaractere = 0;
-    struct termios oldt, newt;
-    int ch;
-    int oldf;
-
-    // mettre le terminal en mode non bloquant
-    tcgetattr(STDIN_FILENO, &oldt);
-    newt = oldt;
-    newt.c_lflag &= ~(ICANON | ECHO);
-    tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-    oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
-    fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
-
-    ch = getchar();
-
-    // restaurer le mode du terminal
-    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-    fcntl(STDIN_FILENO, F_SETFL, oldf);
-
-    if (ch != EOF)
+    // STOP n'attend pas son tour dans la file
+    if (arretLu)
     {
-        ungetc(ch, stdin);
-        unCaractere = 1;
+        *touche = STOP;
     }
-    return unCaractere;
-}
-void disableEcho()
-{
-    struct termios tty;
-
-    // Obtenir les attributs du terminal
-    if (tcgetattr(STDIN_FILENO, &tty) == -1)
+    // une seule touche utile par déplacement, les suivantes attendent le tour d'après
+    while ((*prochaineDirection == direction) && (*touche != STOP) && toucheSuivante(touche))
     {
-        perror("tcgetattr");
-        exit(EXIT_FAILURE);
+        *prochaineDirection = definirDirection(*touche, direction);
     }
+}
 
-    // Desactiver le flag ECHO
-    tty.c_lflag &= ~ECHO;
+void attendreDeplacement(struct timespec *echeance, char *touche, char direction, char *prochaineDirection)
+{
+    struct pollfd entree = {STDIN_FILENO, POLLIN, 0};
+#ifdef __linux__
+    struct timespec attente;
+#endif
+    long long restant = nanosecondesRestantes(echeance);
+    bool ouverte = true;
+    int pret;
+
+    // Touches restées en file depuis le déplacement précédent
+    traiterTouches(touche, direction, prochaineDirection);
+
+    if (restant < -(long long)1000 * VITESSE_INITIAL)
+    {
+        // très en retard (programme suspendu) : on repart de maintenant
+        clock_gettime(CLOCK_MONOTONIC, echeance);
+        restant = 0;
+    }
 
-    // Appliquer les nouvelles configurations
-    if (tcsetattr(STDIN_FILENO, TCSANOW, &tty) == -1)
-    {
-        perror("tcsetattr");
-        exit(EXIT_FAILURE);
+    while (ouverte && (restant > 0) && (*touche != STOP))
+    {
+#ifdef __linux__
+        // ppoll attend à la nanoseconde : le déplacement part à l'échéance, pas à la milliseconde suivante
+        attente.tv_sec = restant / 1000000000;
+        attente.tv_nsec = restant % 1000000000;
+        pret = ppoll(&entree, 1, &attente, NULL);
+#else
+        // poll attend en millisecondes : arrondi au-dessus, le déplacement ne part pas avant l'échéance
+        pret = poll(&entree, 1, (int)((restant + 999999) / 1000000));
+#endif
+        if (pret > 0)
+        {
+            if (lireEntree() < 0)
+            {
+                // entrée fermée : plus rien à lire, on dort jusqu'à l'échéance
+                dormirJusqua(echeance);
+                ouverte = false;
+            }
+            // read interrompu ou file pleine : on continue d'attendre, STOP est retenu à part
+            traiterTouches(touche, direction, prochaineDirection);
+        }
+        restant = nanosecondesRestantes(echeance);
     }
 }
 
-void enableEcho()
+void avancerEcheance(struct timespec *echeance, long microsecondes)
 {
-    struct termios tty;
-
-    // Obtenir les attributs du terminal
-    if (tcgetattr(STDIN_FILENO, &tty) == -1)
+    echeance->tv_sec += microsecondes / 1000000;
+    echeance->tv_nsec += (microsecondes % 1000000) * 1000;
+    if (echeance->tv_nsec >= 1000000000)
     {
-        perror("tcgetattr");
-        exit(EXIT_FAILURE);
+        echeance->tv_sec++;
+        echeance->tv_nsec -= 1000000000;
     }
+}
 
-    // Reactiver le flag ECHO
-    tty.c_lflag |= ECHO;
+long long nanosecondesRestantes(const struct timespec *echeance)
+{
+    struct timespec maintenant;
+    clock_gettime(CLOCK_MONOTONIC, &maintenant);
+    return (long long)(echeance->tv_sec - maintenant.tv_sec) * 1000000000
+         + (echeance->tv_nsec - maintenant.tv_nsec);
+}
 
-    // Appliquer les nouvelles configurations
-    if (tcsetattr(STDIN_FILENO, TCSANOW, &tty) == -1)
-    {
-        perror("tcsetattr");
-        exit(EXIT_FAILURE);
+void dormirJusqua(const struct timespec *echeance)
+{
+#ifdef __linux__
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, echeance, NULL);
+#else
+    struct timespec attente;
+    long long restant = nanosecondesRestantes(echeance);
+
+    // nanosleep est relatif : un réveil par un signal recalcule le temps restant
+    while (restant > 0)
+    {
+        attente.tv_sec = restant / 1000000000;
+        attente.tv_nsec = restant % 1000000000;
+        nanosleep(&attente, NULL);
+        restant = nanosecondesRestantes(echeance);
     }
-}
\ No newline at end of file
+#endif
+}